@@ -14,22 +14,69 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cerrno>
+#include <cfloat>
+#include <clocale>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
 #include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <locale>
-#include <map>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <typeinfo>
 #include <vector>
 
+#if !defined(RAPIDCSV_NO_SIMD)
+#if defined(__AVX2__)
+#define RAPIDCSV_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define RAPIDCSV_SSE2
+#include <emmintrin.h>
+#endif
+#if (defined(RAPIDCSV_AVX2) || defined(RAPIDCSV_SSE2)) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if ((__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L))) && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#if __has_include(<string_view>)
+#include <string_view>
+#endif
+#endif
+#if defined(__cpp_lib_to_chars)
+#define RAPIDCSV_HAS_CHARCONV
+#endif
+#if defined(__cpp_lib_string_view)
+#define RAPIDCSV_HAS_STRING_VIEW
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#define RAPIDCSV_HAS_MMAP
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace rapidcsv
 {
 #if defined(_MSC_VER)
@@ -38,6 +85,9 @@ namespace rapidcsv
   static const bool sPlatformHasCR = false;
 #endif
   static const std::vector<char> s_Utf8BOM = { '\xef', '\xbb', '\xbf' };
+  static const std::vector<char> s_IndexMagic = { 'R', 'C', 'S', 'V', 'I', 'D', 'X', '2' };
+  static const std::vector<char> s_SnapshotMagic = { 'R', 'C', 'S', 'V', 'S', 'N', 'P', '1' };
+  static const uint64_t s_SnapshotByteOrder = 0x0102030405060708;
 
   /**
    * @brief     Datastructure holding parameters controlling how invalid numbers (including
@@ -53,7 +103,8 @@ namespace rapidcsv
      * @param   pDefaultFloat         floating-point default value to represent invalid numbers.
      * @param   pDefaultInteger       integer default value to represent invalid numbers.
      * @param   pNumericLocale        specifies whether to honor LC_NUMERIC locale (default
-     *                                true).
+     *                                true). When false, numbers are converted using a fast
+     *                                locale-independent implementation.
      */
     explicit ConverterParams(const bool pHasDefaultConverter = false,
                              const long double pDefaultFloat = std::numeric_limits<long double>::signaling_NaN(),
@@ -131,213 +182,788 @@ namespace rapidcsv
      */
     void ToStr(const T& pVal, std::string& pStr) const
     {
-      if (typeid(T) == typeid(int) ||
-          typeid(T) == typeid(short) ||
-          typeid(T) == typeid(unsigned short) ||
-          typeid(T) == typeid(long) ||
-          typeid(T) == typeid(long long) ||
-          typeid(T) == typeid(unsigned) ||
-          typeid(T) == typeid(unsigned long) ||
-          typeid(T) == typeid(unsigned long long) ||
-          typeid(T) == typeid(long double) ||
-          typeid(T) == typeid(char))
+      ToStrImpl(pVal, pStr);
+    }
+
+    /**
+     * @brief   Converts string holding a numerical value to numerical datatype representation.
+     * @param   pVal                  numerical value
+     * @param   pStr                  output string
+     */
+    void ToVal(const std::string& pStr, T& pVal) const
+    {
+      ToValImpl(pStr, pVal);
+    }
+
+  private:
+    // The conversion for a datatype is selected at compile time by overload resolution, where
+    // the non-template overloads for supported datatypes take precedence over the template
+    // overload for unsupported ones.
+    template<typename U>
+    void ToStrImpl(const U& /*pVal*/, std::string& /*pStr*/) const
+    {
+      throw no_converter();
+    }
+
+    void ToStrImpl(const int& pVal, std::string& pStr) const
+    {
+      IntegerToStr(pVal, pStr);
+    }
+
+    void ToStrImpl(const short& pVal, std::string& pStr) const
+    {
+      IntegerToStr(pVal, pStr);
+    }
+
+    void ToStrImpl(const unsigned short& pVal, std::string& pStr) const
+    {
+      IntegerToStr(pVal, pStr);
+    }
+
+    void ToStrImpl(const long& pVal, std::string& pStr) const
+    {
+      IntegerToStr(pVal, pStr);
+    }
+
+    void ToStrImpl(const long long& pVal, std::string& pStr) const
+    {
+      IntegerToStr(pVal, pStr);
+    }
+
+    void ToStrImpl(const unsigned& pVal, std::string& pStr) const
+    {
+      IntegerToStr(pVal, pStr);
+    }
+
+    void ToStrImpl(const unsigned long& pVal, std::string& pStr) const
+    {
+      IntegerToStr(pVal, pStr);
+    }
+
+    void ToStrImpl(const unsigned long long& pVal, std::string& pStr) const
+    {
+      IntegerToStr(pVal, pStr);
+    }
+
+    void ToStrImpl(const long double& pVal, std::string& pStr) const
+    {
+      FloatToStr(pVal, pStr, 6);
+    }
+
+    void ToStrImpl(const char& pVal, std::string& pStr) const
+    {
+      StreamToStr(pVal, pStr);
+    }
+
+    void ToStrImpl(const float& pVal, std::string& pStr) const
+    {
+      FloatToStr(pVal, pStr, 9);
+    }
+
+    void ToStrImpl(const double& pVal, std::string& pStr) const
+    {
+      FloatToStr(pVal, pStr, 17);
+    }
+
+    void ToStrImpl(const signed char& pVal, std::string& pStr) const
+    {
+      IntegerToStr(static_cast<int>(pVal), pStr);
+    }
+
+    void ToStrImpl(const unsigned char& pVal, std::string& pStr) const
+    {
+      IntegerToStr(static_cast<unsigned int>(pVal), pStr);
+    }
+
+    template<typename U>
+    static void StreamToStr(const U& pVal, std::string& pStr, const int pPrecision = -1)
+    {
+      std::ostringstream out;
+      if (pPrecision >= 0)
+      {
+        out << std::setprecision(pPrecision);
+      }
+      out << pVal;
+      pStr = out.str();
+    }
+
+    template<typename U>
+    void IntegerToStr(const U& pVal, std::string& pStr) const
+    {
+      if (mConverterParams.mNumericLocale)
+      {
+        StreamToStr(pVal, pStr);
+        return;
+      }
+
+#if defined(RAPIDCSV_HAS_CHARCONV)
+      char buf[32];
+      const std::to_chars_result result = std::to_chars(buf, buf + sizeof(buf), pVal);
+      pStr.assign(buf, result.ptr);
+#else
+      pStr = std::to_string(pVal);
+#endif
+    }
+
+    // Formats the value like an output stream with the classic locale and the specified
+    // precision does, i.e. as the printf format %.*g in the "C" locale.
+    template<typename U>
+    void FloatToStr(const U& pVal, std::string& pStr, const int pPrecision) const
+    {
+      if (mConverterParams.mNumericLocale)
       {
-        std::ostringstream out;
-        out << pVal;
-        pStr = out.str();
+        StreamToStr(pVal, pStr, pPrecision);
+        return;
       }
-      else if (typeid(T) == typeid(float))
+
+      char buf[64];
+#if defined(RAPIDCSV_HAS_CHARCONV)
+      const std::to_chars_result result =
+        std::to_chars(buf, buf + sizeof(buf), pVal, std::chars_format::general, pPrecision);
+      pStr.assign(buf, result.ptr);
+#else
+      const int length = FormatFloat(buf, sizeof(buf), pVal, pPrecision);
+      pStr.assign(buf, static_cast<size_t>(std::max(length, 0)));
+
+      // snprintf honors the LC_NUMERIC decimal point
+      const char decimalPoint = *std::localeconv()->decimal_point;
+      if (decimalPoint != '.')
       {
-        std::ostringstream out;
-        out << std::setprecision(9) << pVal;
-        pStr = out.str();
+        std::replace(pStr.begin(), pStr.end(), decimalPoint, '.');
       }
-      else if (typeid(T) == typeid(double))
+#endif
+    }
+
+#if !defined(RAPIDCSV_HAS_CHARCONV)
+    static int FormatFloat(char* pBuf, const size_t pSize, const double pVal, const int pPrecision)
+    {
+      return std::snprintf(pBuf, pSize, "%.*g", pPrecision, pVal);
+    }
+
+    static int FormatFloat(char* pBuf, const size_t pSize, const long double pVal, const int pPrecision)
+    {
+      return std::snprintf(pBuf, pSize, "%.*Lg", pPrecision, pVal);
+    }
+#endif
+
+    template<typename U>
+    void ToValImpl(const std::string& /*pStr*/, U& /*pVal*/) const
+    {
+      throw no_converter();
+    }
+
+    void ToValImpl(const std::string& pStr, int& pVal) const
+    {
+      ToInteger(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, signed char& pVal) const
+    {
+      ToInteger(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, unsigned char& pVal) const
+    {
+      ToInteger(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, short& pVal) const
+    {
+      ToInteger(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, unsigned short& pVal) const
+    {
+      ToInteger(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, long& pVal) const
+    {
+      ToInteger(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, long long& pVal) const
+    {
+      ToInteger(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, unsigned& pVal) const
+    {
+      ToInteger(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, unsigned long& pVal) const
+    {
+      ToInteger(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, unsigned long long& pVal) const
+    {
+      ToInteger(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, float& pVal) const
+    {
+      ToFloat(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, double& pVal) const
+    {
+      ToFloat(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, long double& pVal) const
+    {
+      ToFloat(pStr, pVal);
+    }
+
+    void ToValImpl(const std::string& pStr, char& pVal) const
+    {
+      pVal = pStr[0];
+    }
+
+    // Invalid input is detected without throwing, so that cells replaced by default values do
+    // not incur the cost of exception handling.
+    template<typename U>
+    void ToInteger(const std::string& pStr, U& pVal) const
+    {
+      const bool isValid = mConverterParams.mNumericLocale ? TryParseInteger(pStr, pVal)
+                                                           : TryParseIntegerClassic(pStr, pVal);
+      if (isValid)
       {
-        std::ostringstream out;
-        out << std::setprecision(17) << pVal;
-        pStr = out.str();
+        return;
       }
-      else if (typeid(T) == typeid(signed char))
+
+      if (mConverterParams.mHasDefaultConverter)
       {
-        std::ostringstream out;
-        out << static_cast<int>(pVal);
-        pStr = out.str();
+        pVal = static_cast<U>(mConverterParams.mDefaultInteger);
+        return;
       }
-      else if (typeid(T) == typeid(unsigned char))
+
+      if (mConverterParams.mNumericLocale)
       {
-        std::ostringstream out;
-        out << static_cast<unsigned int>(pVal);
-        pStr = out.str();
+        // throws the exception reported by std::stoi() and friends
+        ParseInteger(pStr, pVal);
       }
       else
       {
-        throw no_converter();
+        ThrowIntegerClassic(pStr);
       }
     }
 
-    /**
-     * @brief   Converts string holding a numerical value to numerical datatype representation.
-     * @param   pVal                  numerical value
-     * @param   pStr                  output string
-     */
-    void ToVal(const std::string& pStr, T& pVal) const
+    template<typename U>
+    void ToFloat(const std::string& pStr, U& pVal) const
     {
-      try
+      const bool isValid = mConverterParams.mNumericLocale ? TryParseFloat(pStr, pVal)
+                                                           : TryParseFloatClassic(pStr, pVal);
+      if (isValid)
       {
-        if (typeid(T) == typeid(int))
-        {
-          pVal = static_cast<T>(std::stoi(pStr));
-          return;
-        }
-        else if ((typeid(T) == typeid(signed char)) || (typeid(T) == typeid(unsigned char)) ||
-                 (typeid(T) == typeid(short)) || (typeid(T) == typeid(unsigned short)))
-        {
-          const int i = std::stoi(pStr);
-          if ((i < static_cast<int>((std::numeric_limits<T>::min)())) ||
-              (i > static_cast<int>((std::numeric_limits<T>::max)())))
-          {
-            throw std::out_of_range("conversion: out of range");
-          }
-          pVal = static_cast<T>(i);
-          return;
-        }
-        else if (typeid(T) == typeid(long))
-        {
-          pVal = static_cast<T>(std::stol(pStr));
-          return;
-        }
-        else if (typeid(T) == typeid(long long))
-        {
-          pVal = static_cast<T>(std::stoll(pStr));
-          return;
-        }
-        else if ((typeid(T) == typeid(unsigned)) || (typeid(T) == typeid(unsigned long)) ||
-                 (typeid(T) == typeid(unsigned long long)))
-        {
-          const unsigned long long ull = std::stoull(pStr);
-          const T val = static_cast<T>(ull);
+        return;
+      }
 
-          // std::stoull() wraps negative values around, instead of throwing
-          const size_t signPos = pStr.find_first_not_of(" \f\n\r\t\v");
-          const bool isNegative =
-            (ull != 0) && (signPos != std::string::npos) && (pStr.at(signPos) == '-');
+      if (mConverterParams.mHasDefaultConverter)
+      {
+        pVal = static_cast<U>(mConverterParams.mDefaultFloat);
+        return;
+      }
 
-          if (isNegative || (static_cast<unsigned long long>(val) != ull))
-          {
-            throw std::out_of_range("conversion: out of range");
-          }
-          pVal = val;
-          return;
-        }
+      if (mConverterParams.mNumericLocale)
+      {
+        // throws the exception reported by std::stod() and friends
+        ParseFloat(pStr, pVal);
       }
-      catch (...)
+      else
       {
-        if (!mConverterParams.mHasDefaultConverter)
-        {
-          throw;
-        }
-        else
-        {
-          pVal = static_cast<T>(mConverterParams.mDefaultInteger);
-          return;
-        }
+        throw std::invalid_argument("istringstream: no conversion");
       }
+    }
 
-      try
+    // Parses an integer like std::stoi() and friends do, but returns false instead of throwing.
+    template<typename U>
+    static bool TryParseInteger(const std::string& pStr, U& pVal)
+    {
+      const char* str = pStr.c_str();
+      char* end = nullptr;
+      const int savedErrno = errno;
+      errno = 0;
+      bool isValid = false;
+      if (std::numeric_limits<U>::is_signed)
       {
-        if (mConverterParams.mNumericLocale)
-        {
-          if (typeid(T) == typeid(float))
-          {
-            pVal = static_cast<T>(std::stof(pStr));
-            return;
-          }
-          else if (typeid(T) == typeid(double))
-          {
-            pVal = static_cast<T>(std::stod(pStr));
-            return;
-          }
-          else if (typeid(T) == typeid(long double))
-          {
-            pVal = static_cast<T>(std::stold(pStr));
-            return;
-          }
-        }
-        else
+        const long long val = std::strtoll(str, &end, 10);
+        isValid = (end != str) && (errno != ERANGE) &&
+          (val >= static_cast<long long>((std::numeric_limits<U>::min)())) &&
+          (val <= static_cast<long long>((std::numeric_limits<U>::max)()));
+        if (isValid)
         {
-          if ((typeid(T) == typeid(float)) ||
-              (typeid(T) == typeid(double)) ||
-              (typeid(T) == typeid(long double)))
-          {
-            std::istringstream iss(pStr);
-            iss.imbue(std::locale::classic());
-            iss >> pVal;
-            if (iss.fail() || iss.bad() || !iss.eof())
-            {
-              throw std::invalid_argument("istringstream: no conversion");
-            }
-            return;
-          }
+          pVal = static_cast<U>(val);
         }
       }
-      catch (...)
+      else
       {
-        if (!mConverterParams.mHasDefaultConverter)
-        {
-          throw;
-        }
-        else
+        const unsigned long long val = std::strtoull(str, &end, 10);
+
+        // std::strtoull() wraps negative values around
+        const size_t signPos = pStr.find_first_not_of(" \f\n\r\t\v");
+        const bool isNegative =
+          (val != 0) && (signPos != std::string::npos) && (pStr.at(signPos) == '-');
+        isValid = (end != str) && (errno != ERANGE) && !isNegative &&
+          (val <= static_cast<unsigned long long>((std::numeric_limits<U>::max)()));
+        if (isValid)
         {
-          pVal = static_cast<T>(mConverterParams.mDefaultFloat);
-          return;
+          pVal = static_cast<U>(val);
         }
       }
 
-      if (typeid(T) == typeid(char))
-      {
-        pVal = static_cast<T>(pStr[0]);
-        return;
-      }
-      else
+      errno = savedErrno;
+      return isValid;
+    }
+
+    // Parses a floating-point number like std::stod() and friends do, but returns false instead
+    // of throwing.
+    template<typename U>
+    static bool TryParseFloat(const std::string& pStr, U (*pStrToFloat)(const char*, char**), U& pVal)
+    {
+      const char* str = pStr.c_str();
+      char* end = nullptr;
+      const int savedErrno = errno;
+      errno = 0;
+      const U val = pStrToFloat(str, &end);
+      const bool isValid = (end != str) && (errno != ERANGE);
+      if (isValid)
       {
-        throw no_converter();
+        pVal = val;
       }
+
+      errno = savedErrno;
+      return isValid;
     }
 
-  private:
-    const ConverterParams& mConverterParams;
-  };
+    static bool TryParseFloat(const std::string& pStr, float& pVal)
+    {
+      return TryParseFloat<float>(pStr, std::strtof, pVal);
+    }
 
-  /**
-   * @brief     Specialized implementation handling string to string conversion.
-   * @param     pVal                  string
-   * @param     pStr                  string
-   */
-  template<>
-  inline void Converter<std::string>::ToStr(const std::string& pVal, std::string& pStr) const
-  {
-    pStr = pVal;
-  }
+    static bool TryParseFloat(const std::string& pStr, double& pVal)
+    {
+      return TryParseFloat<double>(pStr, std::strtod, pVal);
+    }
 
-  /**
-   * @brief     Specialized implementation handling string to string conversion.
-   * @param     pVal                  string
-   * @param     pStr                  string
-   */
-  template<>
-  inline void Converter<std::string>::ToVal(const std::string& pStr, std::string& pVal) const
-  {
-    pVal = pStr;
-  }
+    static bool TryParseFloat(const std::string& pStr, long double& pVal)
+    {
+      return TryParseFloat<long double>(pStr, std::strtold, pVal);
+    }
 
-  template<typename T>
-  using ConvFunc = std::function<void (const std::string& pStr, T& pVal)>;
+    // Parses a floating-point number the way an input stream with the classic locale does,
+    // requiring all characters but leading whitespace to be consumed.
+    template<typename U>
+    static bool TryParseFloatClassic(const std::string& pStr, U& pVal)
+    {
+      // reject input without a leading number, such as empty cells, without the cost of a stream
+      const size_t numberPos = pStr.find_first_not_of(" \f\n\r\t\v");
+      const size_t mantissaPos = ((numberPos != std::string::npos) &&
+                                  ((pStr[numberPos] == '-') || (pStr[numberPos] == '+'))) ?
+                                 (numberPos + 1) : numberPos;
+      if ((mantissaPos >= pStr.size()) || (!IsDigit(pStr[mantissaPos]) && (pStr[mantissaPos] != '.')))
+      {
+        return false;
+      }
 
-  /**
-   * @brief     Datastructure holding parameters controlling which row and column should be
-   *            treated as labels.
-   */
+      if (ParseFloatClassic(pStr, pVal))
+      {
+        return true;
+      }
+
+      // handle out of range values and remaining input the way an input stream does
+      std::istringstream iss(pStr);
+      iss.imbue(std::locale::classic());
+      U val = 0;
+      iss >> val;
+      if (iss.fail() || iss.bad() || !iss.eof())
+      {
+        return false;
+      }
+
+      pVal = val;
+      return true;
+    }
+
+    static void ParseInteger(const std::string& pStr, int& pVal)
+    {
+      pVal = std::stoi(pStr);
+    }
+
+    static void ParseInteger(const std::string& pStr, signed char& pVal)
+    {
+      ParseNarrow(pStr, pVal);
+    }
+
+    static void ParseInteger(const std::string& pStr, unsigned char& pVal)
+    {
+      ParseNarrow(pStr, pVal);
+    }
+
+    static void ParseInteger(const std::string& pStr, short& pVal)
+    {
+      ParseNarrow(pStr, pVal);
+    }
+
+    static void ParseInteger(const std::string& pStr, unsigned short& pVal)
+    {
+      ParseNarrow(pStr, pVal);
+    }
+
+    static void ParseInteger(const std::string& pStr, long& pVal)
+    {
+      pVal = std::stol(pStr);
+    }
+
+    static void ParseInteger(const std::string& pStr, long long& pVal)
+    {
+      pVal = std::stoll(pStr);
+    }
+
+    static void ParseInteger(const std::string& pStr, unsigned& pVal)
+    {
+      ParseUnsigned(pStr, pVal);
+    }
+
+    static void ParseInteger(const std::string& pStr, unsigned long& pVal)
+    {
+      ParseUnsigned(pStr, pVal);
+    }
+
+    static void ParseInteger(const std::string& pStr, unsigned long long& pVal)
+    {
+      ParseUnsigned(pStr, pVal);
+    }
+
+    template<typename U>
+    static void ParseNarrow(const std::string& pStr, U& pVal)
+    {
+      const int i = std::stoi(pStr);
+      if ((i < static_cast<int>((std::numeric_limits<U>::min)())) ||
+          (i > static_cast<int>((std::numeric_limits<U>::max)())))
+      {
+        throw std::out_of_range("conversion: out of range");
+      }
+      pVal = static_cast<U>(i);
+    }
+
+    template<typename U>
+    static void ParseUnsigned(const std::string& pStr, U& pVal)
+    {
+      const unsigned long long ull = std::stoull(pStr);
+      const U val = static_cast<U>(ull);
+
+      // std::stoull() wraps negative values around, instead of throwing
+      const size_t signPos = pStr.find_first_not_of(" \f\n\r\t\v");
+      const bool isNegative =
+        (ull != 0) && (signPos != std::string::npos) && (pStr.at(signPos) == '-');
+
+      if (isNegative || (static_cast<unsigned long long>(val) != ull))
+      {
+        throw std::out_of_range("conversion: out of range");
+      }
+      pVal = val;
+    }
+
+    static bool IsSpace(const char pCh)
+    {
+      return (pCh == ' ') || ((pCh >= '\t') && (pCh <= '\r'));
+    }
+
+    static bool IsDigit(const char pCh)
+    {
+      return (pCh >= '0') && (pCh <= '9');
+    }
+
+    // Parses an integer like std::stoi() does in the "C" locale, i.e. skipping leading
+    // whitespace and ignoring trailing characters. Returns false for invalid or out of range
+    // input.
+    template<typename U>
+    static bool TryParseIntegerClassic(const std::string& pStr, U& pVal)
+    {
+      const char* pos = pStr.c_str();
+      const char* end = pos + pStr.size();
+      while ((pos < end) && IsSpace(*pos))
+      {
+        ++pos;
+      }
+
+      const bool isNegative = (pos < end) && (*pos == '-');
+      if ((pos < end) && ((*pos == '-') || (*pos == '+')))
+      {
+        ++pos;
+      }
+
+      if ((pos == end) || !IsDigit(*pos))
+      {
+        return false;
+      }
+
+      unsigned long long magnitude = 0;
+#if defined(RAPIDCSV_HAS_CHARCONV)
+      if (std::from_chars(pos, end, magnitude).ec != std::errc())
+      {
+        return false;
+      }
+#else
+      const unsigned long long maxMagnitude = (std::numeric_limits<unsigned long long>::max)();
+      for (; (pos < end) && IsDigit(*pos); ++pos)
+      {
+        const unsigned long long digit = static_cast<unsigned long long>(*pos - '0');
+        if (magnitude > ((maxMagnitude - digit) / 10))
+        {
+          return false;
+        }
+        magnitude = (magnitude * 10) + digit;
+      }
+#endif
+
+      const unsigned long long maxVal = static_cast<unsigned long long>((std::numeric_limits<U>::max)());
+      if (!isNegative)
+      {
+        if (magnitude > maxVal)
+        {
+          return false;
+        }
+        pVal = static_cast<U>(magnitude);
+      }
+      else if (magnitude == 0)
+      {
+        pVal = 0;
+      }
+      else
+      {
+        // the magnitude of the minimum of a signed type exceeds its maximum by one
+        if (!std::numeric_limits<U>::is_signed || ((magnitude - 1) > maxVal))
+        {
+          return false;
+        }
+        pVal = static_cast<U>(-static_cast<long long>(magnitude - 1) - 1);
+      }
+
+      return true;
+    }
+
+    // Throws the exception corresponding to input rejected by TryParseIntegerClassic().
+    static void ThrowIntegerClassic(const std::string& pStr)
+    {
+      size_t pos = pStr.find_first_not_of(" \f\n\r\t\v");
+      if ((pos != std::string::npos) && ((pStr[pos] == '-') || (pStr[pos] == '+')))
+      {
+        ++pos;
+      }
+
+      if ((pos >= pStr.size()) || !IsDigit(pStr[pos]))
+      {
+        throw std::invalid_argument("conversion: no digits");
+      }
+
+      throw std::out_of_range("conversion: out of range");
+    }
+
+    // Parses a floating-point number the way an input stream with the classic locale does,
+    // requiring all characters but leading whitespace to be consumed. Returns false for input
+    // not handled, i.e. invalid, out of range or, without std::from_chars(), not exactly
+    // representable by fast floating-point arithmetic.
+    template<typename U>
+    static bool ParseFloatClassic(const std::string& pStr, U& pVal)
+    {
+      const char* pos = pStr.c_str();
+      const char* end = pos + pStr.size();
+      while ((pos < end) && IsSpace(*pos))
+      {
+        ++pos;
+      }
+
+#if defined(RAPIDCSV_HAS_CHARCONV)
+      // std::from_chars() does not accept a plus sign, but accepts infinity and nan
+      const char* number = ((pos < end) && (*pos == '+')) ? (pos + 1) : pos;
+      const char* mantissa = ((number < end) && (*number == '-') && (number == pos)) ? (number + 1) : number;
+      if ((mantissa == end) || (!IsDigit(*mantissa) && (*mantissa != '.')))
+      {
+        return false;
+      }
+
+      U val = 0;
+      const std::from_chars_result result = std::from_chars(number, end, val);
+      if ((result.ec != std::errc()) || (result.ptr != end))
+      {
+        return false;
+      }
+
+      pVal = val;
+      return true;
+#else
+      return ParseFloatFast(pos, end, pVal);
+#endif
+    }
+
+#if !defined(RAPIDCSV_HAS_CHARCONV)
+    static bool ParseFloatFast(const char* pPos, const char* pEnd, float& pVal)
+    {
+      // single precision arithmetic is exact for mantissas up to 2^24 and powers of ten up to 10^10
+      return ParseFloatFast<float>(pPos, pEnd, 1ULL << 24, 10, pVal);
+    }
+
+    static bool ParseFloatFast(const char* pPos, const char* pEnd, double& pVal)
+    {
+      // double precision arithmetic is exact for mantissas up to 2^53 and powers of ten up to 10^22
+      return ParseFloatFast<double>(pPos, pEnd, 1ULL << 53, 22, pVal);
+    }
+
+    static bool ParseFloatFast(const char* /*pPos*/, const char* /*pEnd*/, long double& /*pVal*/)
+    {
+      return false;
+    }
+
+    // Parses decimal numbers whose mantissa and power of ten are both exactly representable,
+    // in which case a single multiplication or division is correctly rounded (Clinger's fast
+    // path).
+    template<typename U>
+    static bool ParseFloatFast(const char* pPos, const char* pEnd, const unsigned long long pMaxMantissa,
+                               const int pMaxExponent, U& pVal)
+    {
+#if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0)
+      static const U s_Pow10[] =
+      {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+
+      const char* pos = pPos;
+      const bool isNegative = (pos < pEnd) && (*pos == '-');
+      if ((pos < pEnd) && ((*pos == '-') || (*pos == '+')))
+      {
+        ++pos;
+      }
+
+      unsigned long long mantissa = 0;
+      int exponent = 0;
+      bool hasDigits = false;
+      for (; (pos < pEnd) && IsDigit(*pos); ++pos)
+      {
+        mantissa = (mantissa * 10) + static_cast<unsigned long long>(*pos - '0');
+        hasDigits = true;
+        if (mantissa > pMaxMantissa)
+        {
+          return false;
+        }
+      }
+
+      if ((pos < pEnd) && (*pos == '.'))
+      {
+        for (++pos; (pos < pEnd) && IsDigit(*pos); ++pos)
+        {
+          mantissa = (mantissa * 10) + static_cast<unsigned long long>(*pos - '0');
+          --exponent;
+          hasDigits = true;
+          if (mantissa > pMaxMantissa)
+          {
+            return false;
+          }
+        }
+      }
+
+      if (!hasDigits)
+      {
+        return false;
+      }
+
+      if ((pos < pEnd) && ((*pos == 'e') || (*pos == 'E')))
+      {
+        ++pos;
+        const bool isExponentNegative = (pos < pEnd) && (*pos == '-');
+        if ((pos < pEnd) && ((*pos == '-') || (*pos == '+')))
+        {
+          ++pos;
+        }
+
+        if ((pos == pEnd) || !IsDigit(*pos))
+        {
+          return false;
+        }
+
+        int exponentVal = 0;
+        for (; (pos < pEnd) && IsDigit(*pos); ++pos)
+        {
+          exponentVal = (exponentVal * 10) + (*pos - '0');
+          if (exponentVal > 1000)
+          {
+            return false;
+          }
+        }
+        exponent += isExponentNegative ? -exponentVal : exponentVal;
+      }
+
+      if ((pos != pEnd) || (exponent > pMaxExponent) || (exponent < -pMaxExponent))
+      {
+        return false;
+      }
+
+      const U val = (exponent < 0) ? (static_cast<U>(mantissa) / s_Pow10[-exponent])
+                                   : (static_cast<U>(mantissa) * s_Pow10[exponent]);
+      pVal = isNegative ? -val : val;
+      return true;
+#else
+      (void)pPos;
+      (void)pEnd;
+      (void)pMaxMantissa;
+      (void)pMaxExponent;
+      (void)pVal;
+      return false;
+#endif
+    }
+#endif
+
+    static void ParseFloat(const std::string& pStr, float& pVal)
+    {
+      pVal = std::stof(pStr);
+    }
+
+    static void ParseFloat(const std::string& pStr, double& pVal)
+    {
+      pVal = std::stod(pStr);
+    }
+
+    static void ParseFloat(const std::string& pStr, long double& pVal)
+    {
+      pVal = std::stold(pStr);
+    }
+
+    const ConverterParams& mConverterParams;
+  };
+
+  /**
+   * @brief     Specialized implementation handling string to string conversion.
+   * @param     pVal                  string
+   * @param     pStr                  string
+   */
+  template<>
+  inline void Converter<std::string>::ToStr(const std::string& pVal, std::string& pStr) const
+  {
+    pStr = pVal;
+  }
+
+  /**
+   * @brief     Specialized implementation handling string to string conversion.
+   * @param     pVal                  string
+   * @param     pStr                  string
+   */
+  template<>
+  inline void Converter<std::string>::ToVal(const std::string& pStr, std::string& pVal) const
+  {
+    pVal = pStr;
+  }
+
+  template<typename T>
+  using ConvFunc = std::function<void (const std::string& pStr, T& pVal)>;
+
+  /**
+   * @brief     Datastructure holding parameters controlling which row and column should be
+   *            treated as labels.
+   */
   struct LabelParams
   {
     /**
@@ -480,732 +1106,5554 @@ namespace rapidcsv
   };
 
   /**
-   * @brief     Class representing a CSV document.
+   * @brief     Datastructure holding parameters controlling how CSV data is loaded.
    */
-  class Document
+  struct LoadParams
   {
-  public:
     /**
      * @brief   Constructor
-     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
-     *                                data with.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pMemoryMap            specifies whether to memory map files loaded by path and parse
+     *                                the mapped data directly, instead of reading it through a
+     *                                stream. Only supported on POSIX platforms, others fall back to
+     *                                reading through a stream. Default: false
+     * @param   pThreadCount          specifies the number of threads parsing the CSV data. Values
+     *                                above one split the data into chunks parsed concurrently,
+     *                                which requires data read through a stream to be buffered in
+     *                                full. Zero uses the number of hardware threads. Default: 1
+     * @param   pRowCountHint         specifies the expected number of rows, for which storage is
+     *                                reserved before parsing. Zero estimates it from the number of
+     *                                linebreaks in the first 16 KiB of data. Default: 0
+     * @param   pColumnIndices        specifies zero-based indices of columns to load, excluding
+     *                                the row label column. Together with pColumnNames, loading is
+     *                                restricted to the specified columns, which keep their
+     *                                relative order, while cells of other columns are skipped
+     *                                by the parser. Default: all columns
+     * @param   pColumnNames          specifies names of columns to load, looked up in the column
+     *                                label row. Default: all columns
+     * @param   pSkipRowCount         specifies the number of data rows (excluding label rows) to
+     *                                skip before loading rows. Default: 0
+     * @param   pMaxRowCount          specifies the maximum number of data rows to load, following
+     *                                the skipped ones, after which no further data is read.
+     *                                Default: all rows
+     * @param   pRowFilter            specifies a function deciding whether to load a data row,
+     *                                within the range of rows to load, given the cells of the row
+     *                                as loaded, i.e. including a row label cell and only holding
+     *                                selected columns. Default: all rows
      */
-    explicit Document(const std::string& pPath = std::string(),
-                      const LabelParams& pLabelParams = LabelParams(),
-                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
-                      const ConverterParams& pConverterParams = ConverterParams(),
-                      const LineReaderParams& pLineReaderParams = LineReaderParams())
-      : mPath(pPath)
-      , mLabelParams(pLabelParams)
-      , mSeparatorParams(pSeparatorParams)
-      , mConverterParams(pConverterParams)
-      , mLineReaderParams(pLineReaderParams)
-      , mData()
-      , mColumnNames()
-      , mRowNames()
+    explicit LoadParams(const bool pMemoryMap = false, const size_t pThreadCount = 1,
+                        const size_t pRowCountHint = 0,
+                        const std::vector<size_t>& pColumnIndices = std::vector<size_t>(),
+                        const std::vector<std::string>& pColumnNames = std::vector<std::string>(),
+                        const size_t pSkipRowCount = 0,
+                        const size_t pMaxRowCount = std::numeric_limits<size_t>::max(),
+                        const std::function<bool(const std::vector<std::string>& pRow)>& pRowFilter =
+                          std::function<bool(const std::vector<std::string>& pRow)>())
+      : mMemoryMap(pMemoryMap)
+      , mThreadCount(pThreadCount)
+      , mRowCountHint(pRowCountHint)
+      , mColumnIndices(pColumnIndices)
+      , mColumnNames(pColumnNames)
+      , mSkipRowCount(pSkipRowCount)
+      , mMaxRowCount(pMaxRowCount)
+      , mRowFilter(pRowFilter)
     {
-      if (!mPath.empty())
-      {
-        ReadCsv();
-      }
     }
 
     /**
-     * @brief   Constructor
-     * @param   pStream               specifies a binary input stream to read CSV data from.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @brief   specifies whether to memory map files loaded by path.
      */
-    explicit Document(std::istream& pStream,
-                      const LabelParams& pLabelParams = LabelParams(),
-                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
-                      const ConverterParams& pConverterParams = ConverterParams(),
-                      const LineReaderParams& pLineReaderParams = LineReaderParams())
-      : mPath()
-      , mLabelParams(pLabelParams)
-      , mSeparatorParams(pSeparatorParams)
-      , mConverterParams(pConverterParams)
-      , mLineReaderParams(pLineReaderParams)
-      , mData()
-      , mColumnNames()
-      , mRowNames()
-    {
-      ReadCsv(pStream);
-    }
+    bool mMemoryMap;
 
     /**
-     * @brief   Read Document data from file.
-     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
-     *                                data with.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @brief   specifies the number of threads parsing the CSV data.
      */
-    void Load(const std::string& pPath,
-              const LabelParams& pLabelParams = LabelParams(),
-              const SeparatorParams& pSeparatorParams = SeparatorParams(),
-              const ConverterParams& pConverterParams = ConverterParams(),
-              const LineReaderParams& pLineReaderParams = LineReaderParams())
-    {
-      mPath = pPath;
-      mLabelParams = pLabelParams;
-      mSeparatorParams = pSeparatorParams;
-      mConverterParams = pConverterParams;
-      mLineReaderParams = pLineReaderParams;
-      ReadCsv();
-    }
+    size_t mThreadCount;
 
     /**
-     * @brief   Read Document data from stream.
-     * @param   pStream               specifies a binary input stream to read CSV data from.
-     * @param   pLabelParams          specifies which row and column should be treated as labels.
-     * @param   pSeparatorParams      specifies which field and row separators should be used.
-     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
-     *                                handled.
-     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @brief   specifies the expected number of rows, or zero to estimate it.
      */
-    void Load(std::istream& pStream,
-              const LabelParams& pLabelParams = LabelParams(),
-              const SeparatorParams& pSeparatorParams = SeparatorParams(),
-              const ConverterParams& pConverterParams = ConverterParams(),
-              const LineReaderParams& pLineReaderParams = LineReaderParams())
+    size_t mRowCountHint;
+
+    /**
+     * @brief   specifies indices of columns to load.
+     */
+    std::vector<size_t> mColumnIndices;
+
+    /**
+     * @brief   specifies names of columns to load.
+     */
+    std::vector<std::string> mColumnNames;
+
+    /**
+     * @brief   specifies the number of data rows to skip.
+     */
+    size_t mSkipRowCount;
+
+    /**
+     * @brief   specifies the maximum number of data rows to load.
+     */
+    size_t mMaxRowCount;
+
+    /**
+     * @brief   specifies a function deciding whether to load a data row.
+     */
+    std::function<bool(const std::vector<std::string>& pRow)> mRowFilter;
+  };
+
+  /**
+   * @brief     Enumeration of layouts for storing the cells of a loaded Document.
+   */
+  enum class StorageLayout
+  {
+    /**
+     * @brief   each row is stored as a vector of strings.
+     */
+    RowMajor,
+
+    /**
+     * @brief   all cells are stored in a few large buffers (slabs), indexed by cell offsets.
+     */
+    Buffer,
+
+    /**
+     * @brief   each column is stored as a vector of strings.
+     */
+    ColumnMajor,
+  };
+
+  /**
+   * @brief     Datastructure holding parameters controlling how Document data is stored.
+   */
+  struct StorageParams
+  {
+    /**
+     * @brief   Constructor
+     * @param   pLayout               specifies the storage layout of loaded Document cells.
+     *                                StorageLayout::Buffer documents are converted to
+     *                                StorageLayout::RowMajor upon their first modification, while
+     *                                StorageLayout::ColumnMajor documents are converted upon their
+     *                                first modification of rows or row names.
+     *                                Default: StorageLayout::RowMajor
+     * @param   pColumnCache          specifies whether columns converted by GetColumn() are kept
+     *                                in a cache, per column and data type, until the column is
+     *                                modified. Concurrent GetColumn() calls are not thread-safe
+     *                                with the cache enabled (default false).
+     * @param   pDictionaryColumns    specifies names of columns to be dictionary encoded by
+     *                                StorageLayout::ColumnMajor documents, storing a code per cell
+     *                                referring to a dictionary of distinct values. Encoded columns
+     *                                are decoded upon their first modification (default none).
+     * @param   pDictionaryMaxSize    specifies the maximum number of distinct values of other
+     *                                columns to be dictionary encoded automatically, which are
+     *                                those with at most one distinct value per four cells among
+     *                                their first 1024 cells. Zero disables automatic encoding
+     *                                (default 0).
+     */
+    explicit StorageParams(const StorageLayout pLayout = StorageLayout::RowMajor,
+                           const bool pColumnCache = false,
+                           const std::vector<std::string>& pDictionaryColumns = std::vector<std::string>(),
+                           const size_t pDictionaryMaxSize = 0)
+      : mLayout(pLayout)
+      , mColumnCache(pColumnCache)
+      , mDictionaryColumns(pDictionaryColumns)
+      , mDictionaryMaxSize(pDictionaryMaxSize)
     {
-      mPath = "";
-      mLabelParams = pLabelParams;
-      mSeparatorParams = pSeparatorParams;
-      mConverterParams = pConverterParams;
-      mLineReaderParams = pLineReaderParams;
-      ReadCsv(pStream);
     }
 
     /**
-     * @brief   Write Document data to file.
-     * @param   pPath                 optionally specifies the path where the CSV-file will be created
-     *                                (if not specified, the original path provided when creating or
-     *                                loading the Document data will be used).
+     * @brief   specifies the storage layout of loaded Document cells.
      */
-    void Save(const std::string& pPath = std::string())
+    StorageLayout mLayout;
+
+    /**
+     * @brief   specifies whether columns converted by GetColumn() are cached.
+     */
+    bool mColumnCache;
+
+    /**
+     * @brief   specifies names of columns to be dictionary encoded.
+     */
+    std::vector<std::string> mDictionaryColumns;
+
+    /**
+     * @brief   specifies the maximum number of distinct values of automatically encoded columns.
+     */
+    size_t mDictionaryMaxSize;
+  };
+
+  /**
+   * @brief     Datastructure holding statistics of the memory allocated for Document cells.
+   */
+  struct StorageStats
+  {
+    /**
+     * @brief   number of slabs holding cells of StorageLayout::Buffer documents.
+     */
+    size_t mSlabCount = 0;
+
+    /**
+     * @brief   number of bytes allocated for slabs.
+     */
+    size_t mSlabBytes = 0;
+
+    /**
+     * @brief   number of bytes of cell data stored in slabs.
+     */
+    size_t mSlabUsedBytes = 0;
+
+    /**
+     * @brief   number of cells stored as strings with memory allocated per cell, i.e. not
+     *          fitting the string object itself, by documents of other layouts.
+     */
+    size_t mCellAllocations = 0;
+  };
+
+  /**
+   * @brief     Datastructure holding parameters controlling how a Writer encodes and buffers
+   *            CSV data.
+   */
+  struct WriterParams
+  {
+    /**
+     * @brief   Constructor
+     * @param   pUtf16                specifies whether to write UTF-16 with a byte order mark,
+     *                                instead of UTF-8 (default false).
+     * @param   pLittleEndian         specifies whether UTF-16 is written little endian (default true).
+     * @param   pUtf8BOM              specifies whether to start UTF-8 data with a byte order mark
+     *                                (default false).
+     * @param   pBufferSize           specifies the size in bytes of the internal buffer, which is
+     *                                written to the output when full (default 1 MiB).
+     */
+    explicit WriterParams(const bool pUtf16 = false, const bool pLittleEndian = true,
+                          const bool pUtf8BOM = false, const size_t pBufferSize = 1024 * 1024)
+      : mUtf16(pUtf16)
+      , mLittleEndian(pLittleEndian)
+      , mUtf8BOM(pUtf8BOM)
+      , mBufferSize(pBufferSize)
     {
-      if (!pPath.empty())
-      {
-        mPath = pPath;
-      }
-      WriteCsv();
     }
 
     /**
-     * @brief   Write Document data to stream.
-     * @param   pStream               specifies a binary output stream to write the data to.
+     * @brief   specifies whether to write UTF-16 with a byte order mark.
      */
-    void Save(std::ostream& pStream) const
+    bool mUtf16;
+
+    /**
+     * @brief   specifies whether UTF-16 is written little endian.
+     */
+    bool mLittleEndian;
+
+    /**
+     * @brief   specifies whether to start UTF-8 data with a byte order mark.
+     */
+    bool mUtf8BOM;
+
+    /**
+     * @brief   specifies the size in bytes of the internal buffer.
+     */
+    size_t mBufferSize;
+  };
+
+  /**
+   * @brief     Datastructure holding parameters controlling how an IndexedReader indexes and
+   *            caches rows of a CSV file.
+   */
+  struct IndexParams
+  {
+    /**
+     * @brief   Constructor
+     * @param   pRowStride            specifies the number of rows per indexed block, i.e. the byte
+     *                                offset of every pRowStride:th row is stored (default 1024).
+     * @param   pCacheBlockCount      specifies the maximum number of parsed blocks of rows to keep
+     *                                cached, the least recently used block is evicted first
+     *                                (default 16).
+     * @param   pIndexPath            specifies the path of the index file, an empty string uses
+     *                                the CSV-file path with the suffix ".idx" (default).
+     * @param   pSaveIndex            specifies whether to save a built index to the index file, to be
+     *                                reused as long as the size, modification time and checksum of
+     *                                the first and last 4 KiB of the CSV-file match (default true).
+     *                                Modifications elsewhere in the file, keeping its size, are not
+     *                                detected within the timestamp resolution of the file system, or
+     *                                at all on platforms without POSIX stat(), e.g. Windows. Disable
+     *                                saving, or remove the index file, if such modifications occur.
+     */
+    explicit IndexParams(const size_t pRowStride = 1024, const size_t pCacheBlockCount = 16,
+                         const std::string& pIndexPath = std::string(), const bool pSaveIndex = true)
+      : mRowStride(pRowStride)
+      , mCacheBlockCount(pCacheBlockCount)
+      , mIndexPath(pIndexPath)
+      , mSaveIndex(pSaveIndex)
     {
-      WriteCsv(pStream);
     }
 
     /**
-     * @brief   Clears loaded Document data.
-     *
+     * @brief   specifies the number of rows per indexed block.
      */
-    void Clear()
+    size_t mRowStride;
+
+    /**
+     * @brief   specifies the maximum number of parsed blocks of rows to keep cached.
+     */
+    size_t mCacheBlockCount;
+
+    /**
+     * @brief   specifies the path of the index file, or empty for the CSV-file path with the suffix
+     *          ".idx".
+     */
+    std::string mIndexPath;
+
+    /**
+     * @brief   specifies whether to save a built index to the index file.
+     */
+    bool mSaveIndex;
+  };
+
+  /**
+   * @brief     Class storing rows of cells in a few large buffers (slabs), which are allocated and
+   *            released as a whole. Each cell is represented only by its end offset in the
+   *            buffers, avoiding a heap allocation per cell. Only intended for rapidcsv internal
+   *            usage.
+   */
+  class CellBuffer
+  {
+  public:
+    /**
+     * @brief   Constructor
+     */
+    CellBuffer()
+      : mSlabs()
+      , mSlabOffsets()
+      , mCellOffsets(1, 0)
+      , mRowOffsets(1, 0)
     {
-      mData.clear();
-      mColumnNames.clear();
-      mRowNames.clear();
-      mIsUtf16 = false;
-      mIsLE = false;
-      mHasUtf8BOM = false;
     }
 
     /**
-     * @brief   Get column index by name. The result is undefined if the document contains
-     *          multiple columns sharing the same label name. Column indices exceeding
-     *          INT_MAX are not supported.
-     * @param   pColumnName           column label name.
-     * @returns zero-based column index.
+     * @brief   Reserve buffer capacity, as a slab holding the cells appended until it is full.
+     * @param   pSize                 number of bytes expected to be stored.
      */
-    int GetColumnIdx(const std::string& pColumnName) const
+    void Reserve(const size_t pSize)
     {
-      if (mLabelParams.mColumnNameIdx >= 0)
+      if (mSlabs.empty() && (pSize > 0))
       {
-        if (mColumnNames.find(pColumnName) != mColumnNames.end())
-        {
-          return static_cast<int>(mColumnNames.at(pColumnName)) - (mLabelParams.mRowNameIdx + 1);
-        }
+        AddSlab(pSize);
       }
-      return -1;
     }
 
     /**
-     * @brief   Get column by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @returns vector of column data.
+     * @brief   Reserve capacity for rows. Cell offsets are reserved upon the first appended row,
+     *          assuming subsequent rows have the same number of cells.
+     * @param   pRowCount             number of rows expected to be stored.
      */
-    template<typename T>
-    std::vector<T> GetColumn(const size_t pColumnIdx) const
+    void ReserveRows(const size_t pRowCount)
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      std::vector<T> column;
-      Converter<T> converter(mConverterParams);
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
-      {
-        if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
-        {
-          if (dataColumnIdx < itRow->size())
-          {
-            T val;
-            converter.ToVal(itRow->at(dataColumnIdx), val);
-            column.push_back(val);
-          }
-          else
-          {
-            const std::string errStr = "requested column index " +
-              std::to_string(pColumnIdx) + " >= " +
-              std::to_string(itRow->size() - GetDataColumnIndex(0)) +
-              " (number of columns on row index " +
-              std::to_string(std::distance(mData.begin(), itRow) -
-                             (mLabelParams.mColumnNameIdx + 1)) + ")";
-            throw std::out_of_range(errStr);
-          }
-        }
-      }
-      return column;
+      mRowOffsets.reserve(pRowCount + 1);
     }
 
     /**
-     * @brief   Get column by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pToVal                conversion function.
-     * @returns vector of column data.
+     * @brief   Append row.
+     * @param   pRow                  vector of row cells.
      */
-    template<typename T>
-    std::vector<T> GetColumn(const size_t pColumnIdx, ConvFunc<T> pToVal) const
+    void AppendRow(const std::vector<std::string>& pRow)
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      std::vector<T> column;
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      if (mRowOffsets.size() == 1)
+      {
+        mCellOffsets.reserve(((mRowOffsets.capacity() - 1) * pRow.size()) + 1);
+      }
+
+      const size_t minSlabSize = 1024 * 1024;
+      for (const std::string& cell : pRow)
       {
-        if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
+        // cells never span slabs, so a cell not fitting the last slab starts a new one, sized as
+        // the data stored so far to keep the number of slabs logarithmic
+        if (mSlabs.empty() || ((mSlabs.back().capacity() - mSlabs.back().size()) < cell.size()))
         {
-          T val;
-          pToVal(itRow->at(dataColumnIdx), val);
-          column.push_back(val);
+          AddSlab(std::max(cell.size(), std::max(minSlabSize, mCellOffsets.back())));
         }
+
+        mSlabs.back().append(cell);
+        mCellOffsets.push_back(mCellOffsets.back() + cell.size());
       }
-      return column;
+      mRowOffsets.push_back(mCellOffsets.size() - 1);
     }
 
     /**
-     * @brief   Get column by name.
-     * @param   pColumnName           column label name.
-     * @returns vector of column data.
+     * @brief   Replace all rows with cell data and offsets in the internal representation, which
+     *          are copied in bulk into a single slab rather than appended cell by cell.
+     * @param   pData                 cell data of all cells, concatenated.
+     * @param   pCellOffsets          end offset of each cell in pData, preceded by zero.
+     * @param   pCellCount            number of cells.
+     * @param   pRowOffsets           index of the first cell of each row, followed by pCellCount.
+     * @param   pRowCount             number of rows.
      */
-    template<typename T>
-    std::vector<T> GetColumn(const std::string& pColumnName) const
+    void Assign(const char* pData, const uint64_t* pCellOffsets, const size_t pCellCount,
+                const uint64_t* pRowOffsets, const size_t pRowCount)
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      Clear();
+      const size_t dataSize = static_cast<size_t>(pCellOffsets[pCellCount]);
+      if (dataSize > 0)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        AddSlab(dataSize);
+        mSlabs.back().assign(pData, dataSize);
       }
-      return GetColumn<T>(static_cast<size_t>(columnIdx));
+      mCellOffsets.assign(pCellOffsets, pCellOffsets + pCellCount + 1);
+      mRowOffsets.assign(pRowOffsets, pRowOffsets + pRowCount + 1);
     }
 
     /**
-     * @brief   Get column by name.
-     * @param   pColumnName           column label name.
-     * @param   pToVal                conversion function.
-     * @returns vector of column data.
+     * @brief   Get number of rows.
+     * @returns row count.
      */
-    template<typename T>
-    std::vector<T> GetColumn(const std::string& pColumnName, ConvFunc<T> pToVal) const
+    size_t GetRowCount() const
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
-      {
-        throw std::out_of_range("column not found: " + pColumnName);
-      }
-      return GetColumn<T>(static_cast<size_t>(columnIdx), pToVal);
+      return mRowOffsets.size() - 1;
     }
 
     /**
-     * @brief   Set column by index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pColumn               vector of column data.
+     * @brief   Get number of cells on row.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell count.
      */
-    template<typename T>
-    void SetColumn(const size_t pColumnIdx, const std::vector<T>& pColumn)
+    size_t GetRowSize(const size_t pRowIdx) const
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      CheckRowIdx(pRowIdx);
+      return mRowOffsets[pRowIdx + 1] - mRowOffsets[pRowIdx];
+    }
 
-      while (GetDataRowIndex(pColumn.size()) > GetDataRowCount())
+    /**
+     * @brief   Get cell.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pCell                 output string, its capacity is reused.
+     */
+    void GetCell(const size_t pRowIdx, const size_t pColumnIdx, std::string& pCell) const
+    {
+      if (pColumnIdx >= GetRowSize(pRowIdx))
       {
-        std::vector<std::string> row;
-        row.resize(GetDataColumnCount());
-        mData.push_back(row);
+        throw std::out_of_range("cell buffer column index " + std::to_string(pColumnIdx) + " >= " +
+                                std::to_string(GetRowSize(pRowIdx)));
       }
 
-      if ((dataColumnIdx + 1) > GetDataColumnCount())
+      const size_t cellIdx = mRowOffsets[pRowIdx] + pColumnIdx;
+      const size_t cellOffset = mCellOffsets[cellIdx];
+      const size_t cellSize = mCellOffsets[cellIdx + 1] - cellOffset;
+      if (cellSize == 0)
       {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
-        {
-          if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
-          {
-            itRow->resize(GetDataColumnIndex(dataColumnIdx + 1));
-          }
-        }
+        pCell.clear();
+        return;
       }
 
-      Converter<T> converter(mConverterParams);
-      for (auto itRow = pColumn.begin(); itRow != pColumn.end(); ++itRow)
-      {
-        std::string str;
-        converter.ToStr(*itRow, str);
-        mData.at(static_cast<size_t>(std::distance(pColumn.begin(), itRow) + mLabelParams.mColumnNameIdx + 1)).at(
-          dataColumnIdx) = str;
-      }
+      const size_t slabIdx = (mSlabs.size() == 1) ? 0 :
+        static_cast<size_t>(std::upper_bound(mSlabOffsets.begin(), mSlabOffsets.end(), cellOffset) -
+                            mSlabOffsets.begin()) - 1;
+      pCell.assign(mSlabs[slabIdx], cellOffset - mSlabOffsets[slabIdx], cellSize);
     }
 
     /**
-     * @brief   Set column by name.
-     * @param   pColumnName           column label name.
-     * @param   pColumn               vector of column data.
+     * @brief   Get number of slabs holding the cell data.
+     * @returns slab count.
      */
-    template<typename T>
-    void SetColumn(const std::string& pColumnName, const std::vector<T>& pColumn)
+    size_t GetSlabCount() const
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
-      {
-        throw std::out_of_range("column not found: " + pColumnName);
-      }
-      SetColumn<T>(static_cast<size_t>(columnIdx), pColumn);
+      return mSlabs.size();
     }
 
     /**
-     * @brief   Remove column by index.
-     * @param   pColumnIdx            zero-based column index.
+     * @brief   Get number of bytes allocated for slabs.
+     * @returns allocated byte count.
      */
-    void RemoveColumn(const size_t pColumnIdx)
+    size_t GetSlabBytes() const
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+      size_t slabBytes = 0;
+      for (const std::string& slab : mSlabs)
       {
-        if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
-        {
-          if (dataColumnIdx < itRow->size())
-          {
-            itRow->erase(itRow->begin() + static_cast<std::ptrdiff_t>(dataColumnIdx));
-          }
-          else
-          {
-            const std::string errStr = "column out of range: " +
-              std::to_string(pColumnIdx) + " (on row " +
-              std::to_string(std::distance(mData.begin(), itRow)) +
-              ")";
-            throw std::out_of_range(errStr);
-          }
-        }
+        slabBytes += slab.capacity();
       }
+      return slabBytes;
+    }
 
-      UpdateColumnNames();
+    /**
+     * @brief   Get number of bytes of cell data.
+     * @returns cell data byte count.
+     */
+    size_t GetCellBytes() const
+    {
+      return mCellOffsets.back();
     }
 
     /**
-     * @brief   Remove column by name.
-     * @param   pColumnName           column label name.
+     * @brief   Clears all rows and releases the buffer memory, one deallocation per slab.
      */
-    void RemoveColumn(const std::string& pColumnName)
+    void Clear()
     {
-      int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      std::vector<std::string>().swap(mSlabs);
+      std::vector<size_t>().swap(mSlabOffsets);
+      std::vector<size_t>(1, 0).swap(mCellOffsets);
+      std::vector<size_t>(1, 0).swap(mRowOffsets);
+    }
+
+  private:
+    void CheckRowIdx(const size_t pRowIdx) const
+    {
+      if (pRowIdx >= GetRowCount())
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        throw std::out_of_range("cell buffer row index " + std::to_string(pRowIdx) + " >= " +
+                                std::to_string(GetRowCount()));
       }
+    }
 
-      RemoveColumn(static_cast<size_t>(columnIdx));
+    void AddSlab(const size_t pCapacity)
+    {
+      mSlabOffsets.push_back(mCellOffsets.back());
+      mSlabs.emplace_back();
+      mSlabs.back().reserve(pCapacity);
     }
 
+    // cell offsets span the slabs as if they were concatenated
+    std::vector<std::string> mSlabs;
+    std::vector<size_t> mSlabOffsets;
+    std::vector<size_t> mCellOffsets;
+    std::vector<size_t> mRowOffsets;
+  };
+
+  /**
+   * @brief     Class mapping label names to indices, using open addressing with linear probing
+   *            in a table of slots referring to densely stored names. Names can be looked up
+   *            without constructing a std::string. Setting an existing name replaces its index,
+   *            while adding it counts a duplicate label and keeps the greatest index, i.e. the
+   *            last label with the name. Only intended for rapidcsv internal usage.
+   */
+  class LabelIndex
+  {
+  public:
     /**
-     * @brief   Insert column at specified index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pColumn               vector of column data (optional argument).
-     * @param   pColumnName           column label name (optional argument).
+     * @brief   Constructor
      */
-    template<typename T>
-    void InsertColumn(const size_t pColumnIdx, const std::vector<T>& pColumn = std::vector<T>(),
-                      const std::string& pColumnName = std::string())
+    LabelIndex()
+      : mNames()
+      , mIndices()
+      , mHashes()
+      , mCounts()
+      , mSlots()
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-
-      std::vector<std::string> column;
-      if (pColumn.empty())
-      {
-        column.resize(GetDataRowCount());
-      }
-      else
-      {
-        column.resize(GetDataRowIndex(pColumn.size()));
-        Converter<T> converter(mConverterParams);
-        for (auto itRow = pColumn.begin(); itRow != pColumn.end(); ++itRow)
-        {
-          std::string str;
-          converter.ToStr(*itRow, str);
-          const size_t rowIdx =
-            static_cast<size_t>(std::distance(pColumn.begin(), itRow) + (mLabelParams.mColumnNameIdx + 1));
-          column.at(rowIdx) = str;
-        }
-      }
+    }
 
-      while (column.size() > GetDataRowCount())
+    /**
+     * @brief   Reserve space for names to be set.
+     * @param   pCount                number of names.
+     */
+    void Reserve(const size_t pCount)
+    {
+      mNames.reserve(pCount);
+      mIndices.reserve(pCount);
+      mHashes.reserve(pCount);
+      mCounts.reserve(pCount);
+      if ((pCount * 2) > mSlots.size())
       {
-        std::vector<std::string> row;
-        const size_t columnCount = std::max<size_t>(static_cast<size_t>(mLabelParams.mColumnNameIdx + 1),
-                                                    GetDataColumnCount());
-        row.resize(columnCount);
-        mData.push_back(row);
+        Rehash(pCount * 2);
       }
+    }
 
-      for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
-      {
-        if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
-        {
-          const size_t rowIdx = static_cast<size_t>(std::distance(mData.begin(), itRow));
-          if (dataColumnIdx <= itRow->size())
-          {
-            itRow->insert(itRow->begin() + static_cast<std::ptrdiff_t>(dataColumnIdx), column.at(rowIdx));
-          }
-          else
-          {
-            const std::string errStr = "column out of range: " +
-              std::to_string(pColumnIdx) + " (on row " +
-              std::to_string(std::distance(mData.begin(), itRow)) +
-              ")";
-            throw std::out_of_range(errStr);
-          }
-        }
-      }
+    /**
+     * @brief   Set index of name, replacing the index of an existing name.
+     * @param   pName                 label name.
+     * @param   pIdx                  index.
+     */
+    void Set(const std::string& pName, const size_t pIdx)
+    {
+      mIndices[Emplace(pName, pIdx)] = pIdx;
+    }
 
-      if (!pColumnName.empty())
+    /**
+     * @brief   Add label name with index. An existing name is counted as a duplicate label and
+     *          keeps the greater of its index and the given index.
+     * @param   pName                 label name.
+     * @param   pIdx                  index.
+     */
+    void Add(const std::string& pName, const size_t pIdx)
+    {
+      const size_t count = mNames.size();
+      const size_t pos = Emplace(pName, pIdx);
+      if (mNames.size() == count)
       {
-        SetColumnName(pColumnIdx, pColumnName);
+        mIndices[pos] = std::max(mIndices[pos], pIdx);
+        ++mCounts[pos];
       }
-
-      UpdateColumnNames();
     }
 
     /**
-     * @brief   Get number of data columns (excluding label columns).
-     * @returns column count.
+     * @brief   Insert label name at index, incrementing the indices at or after it.
+     * @param   pName                 label name.
+     * @param   pIdx                  index.
      */
-    size_t GetColumnCount() const
+    void Insert(const std::string& pName, const size_t pIdx)
     {
-      const size_t firstRow = static_cast<size_t>((mLabelParams.mColumnNameIdx >= 0) ? mLabelParams.mColumnNameIdx : 0);
-      const std::ptrdiff_t count =
-        static_cast<std::ptrdiff_t>((mData.size() > firstRow) ? mData.at(firstRow).size() : 0) -
-        (mLabelParams.mRowNameIdx + 1);
-      return (count >= 0) ? static_cast<size_t>(count) : 0;
+      Insert(pIdx);
+      Add(pName, pIdx);
     }
 
     /**
-     * @brief   Get row index by name. The result is undefined if the document contains
-     *          multiple rows sharing the same label name. Row indices exceeding INT_MAX
-     *          are not supported.
-     * @param   pRowName              row label name.
-     * @returns zero-based row index.
+     * @brief   Insert an unnamed label at index, incrementing the indices at or after it.
+     * @param   pIdx                  index.
      */
-    int GetRowIdx(const std::string& pRowName) const
+    void Insert(const size_t pIdx)
     {
-      if (mLabelParams.mRowNameIdx >= 0)
+      for (size_t& idx : mIndices)
       {
-        if (mRowNames.find(pRowName) != mRowNames.end())
+        if (idx >= pIdx)
         {
-          return static_cast<int>(mRowNames.at(pRowName)) - (mLabelParams.mColumnNameIdx + 1);
+          ++idx;
         }
       }
-      return -1;
     }
 
     /**
-     * @brief   Get row by index.
-     * @param   pRowIdx               zero-based row index.
-     * @returns vector of row data.
+     * @brief   Remove label name at index, decrementing the indices after it.
+     * @param   pName                 label name.
+     * @param   pIdx                  index.
+     * @returns true if labels with the name remain while its index referred to the removed
+     *          label, in which case the caller shall set the index of the last remaining one.
      */
-    template<typename T>
-    std::vector<T> GetRow(const size_t pRowIdx) const
+    bool Remove(const std::string& pName, const size_t pIdx)
     {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-      std::vector<T> row;
-      Converter<T> converter(mConverterParams);
-      for (auto itCol = mData.at(dataRowIdx).begin(); itCol != mData.at(dataRowIdx).end(); ++itCol)
-      {
-        if (std::distance(mData.at(dataRowIdx).begin(), itCol) > mLabelParams.mRowNameIdx)
-        {
-          T val;
-          converter.ToVal(*itCol, val);
-          row.push_back(val);
-        }
-      }
-      return row;
+      const bool isStale = Erase(pName, pIdx);
+      Remove(pIdx);
+      return isStale;
     }
 
     /**
-     * @brief   Get row by index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pToVal                conversion function.
-     * @returns vector of row data.
+     * @brief   Remove an unnamed label at index, decrementing the indices after it.
+     * @param   pIdx                  index.
      */
-    template<typename T>
-    std::vector<T> GetRow(const size_t pRowIdx, ConvFunc<T> pToVal) const
+    void Remove(const size_t pIdx)
     {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-      std::vector<T> row;
-      Converter<T> converter(mConverterParams);
-      for (auto itCol = mData.at(dataRowIdx).begin(); itCol != mData.at(dataRowIdx).end(); ++itCol)
+      for (size_t& idx : mIndices)
       {
-        if (std::distance(mData.at(dataRowIdx).begin(), itCol) > mLabelParams.mRowNameIdx)
+        if (idx > pIdx)
         {
-          T val;
-          pToVal(*itCol, val);
-          row.push_back(val);
+          --idx;
         }
       }
-      return row;
     }
 
     /**
-     * @brief   Get row by name.
-     * @param   pRowName              row label name.
-     * @returns vector of row data.
+     * @brief   Find index of name.
+     * @param   pName                 label name, not required to be null-terminated.
+     * @param   pLength               length of label name.
+     * @param   pIdx                  index, only set if the name is found.
+     * @returns true if the name is found.
      */
-    template<typename T>
-    std::vector<T> GetRow(const std::string& pRowName) const
+    bool Find(const char* pName, const size_t pLength, size_t& pIdx) const
     {
-      int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+      if (mNames.empty())
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        return false;
       }
-      return GetRow<T>(static_cast<size_t>(rowIdx));
+
+      const size_t slot = FindSlot(pName, pLength, Hash(pName, pLength));
+      if (mSlots[slot] == 0)
+      {
+        return false;
+      }
+
+      pIdx = mIndices[mSlots[slot] - 1];
+      return true;
     }
 
     /**
-     * @brief   Get row by name.
-     * @param   pRowName              row label name.
-     * @param   pToVal                conversion function.
-     * @returns vector of row data.
+     * @brief   Erase one label name at index, without changing other indices.
+     * @param   pName                 label name.
+     * @param   pIdx                  index.
+     * @returns true if labels with the name remain while its index referred to the erased
+     *          label, in which case the caller shall set the index of the last remaining one.
      */
-    template<typename T>
-    std::vector<T> GetRow(const std::string& pRowName, ConvFunc<T> pToVal) const
+    bool Erase(const std::string& pName, const size_t pIdx)
     {
-      int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+      if (mNames.empty())
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        return false;
       }
-      return GetRow<T>(static_cast<size_t>(rowIdx), pToVal);
+
+      const size_t slot = FindSlot(pName.data(), pName.size(), Hash(pName.data(), pName.size()));
+      if (mSlots[slot] == 0)
+      {
+        return false;
+      }
+
+      const size_t pos = mSlots[slot] - 1;
+      if (mCounts[pos] > 1)
+      {
+        --mCounts[pos];
+        return (mIndices[pos] == pIdx);
+      }
+
+      if (mIndices[pos] == pIdx)
+      {
+        Erase(pName);
+      }
+
+      return false;
     }
 
     /**
-     * @brief   Set row by index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pRow                  vector of row data.
+     * @brief   Erase name, including all its duplicate labels.
+     * @param   pName                 label name.
      */
-    template<typename T>
-    void SetRow(const size_t pRowIdx, const std::vector<T>& pRow)
+    void Erase(const std::string& pName)
     {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      if (mNames.empty())
+      {
+        return;
+      }
 
-      while ((dataRowIdx + 1) > GetDataRowCount())
+      const size_t mask = mSlots.size() - 1;
+      const size_t slot = FindSlot(pName.data(), pName.size(), Hash(pName.data(), pName.size()));
+      if (mSlots[slot] == 0)
       {
-        std::vector<std::string> row;
-        row.resize(GetDataColumnCount());
-        mData.push_back(row);
+        return;
       }
 
-      if (pRow.size() > GetDataColumnCount())
+      // shift following slots back into the hole, unless that would move them before their
+      // home slot, keeping all names reachable without tombstones
+      const size_t pos = mSlots[slot] - 1;
+      size_t hole = slot;
+      for (size_t next = (hole + 1) & mask; mSlots[next] != 0; next = (next + 1) & mask)
       {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        const size_t home = mHashes[mSlots[next] - 1] & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask))
         {
-          if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
-          {
-            itRow->resize(GetDataColumnIndex(pRow.size()));
-          }
+          mSlots[hole] = mSlots[next];
+          hole = next;
         }
       }
+      mSlots[hole] = 0;
 
-      Converter<T> converter(mConverterParams);
-      for (auto itCol = pRow.begin(); itCol != pRow.end(); ++itCol)
+      // move the last name into the erased position
+      const size_t last = mNames.size() - 1;
+      if (pos != last)
       {
-        std::string str;
-        converter.ToStr(*itCol, str);
-        mData.at(dataRowIdx).at(static_cast<size_t>(std::distance(pRow.begin(),
-                                                                  itCol) + mLabelParams.mRowNameIdx + 1)) = str;
+        size_t lastSlot = mHashes[last] & mask;
+        while (mSlots[lastSlot] != (last + 1))
+        {
+          lastSlot = (lastSlot + 1) & mask;
+        }
+
+        mSlots[lastSlot] = pos + 1;
+        mNames[pos].swap(mNames[last]);
+        mIndices[pos] = mIndices[last];
+        mHashes[pos] = mHashes[last];
+        mCounts[pos] = mCounts[last];
       }
+
+      mNames.pop_back();
+      mIndices.pop_back();
+      mHashes.pop_back();
+      mCounts.pop_back();
     }
 
     /**
-     * @brief   Set row by name.
-     * @param   pRowName              row label name.
-     * @param   pRow                  vector of row data.
+     * @brief   Clear all names.
      */
-    template<typename T>
-    void SetRow(const std::string& pRowName, const std::vector<T>& pRow)
+    void Clear()
     {
-      int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-      return SetRow<T>(static_cast<size_t>(rowIdx), pRow);
+      mNames.clear();
+      mIndices.clear();
+      mHashes.clear();
+      mCounts.clear();
+      mSlots.clear();
     }
 
-    /**
-     * @brief   Remove row by index.
-     * @param   pRowIdx               zero-based row index.
-     */
-    void RemoveRow(const size_t pRowIdx)
+  private:
+    // Returns the position of the name, adding the name with the index if not found.
+    size_t Emplace(const std::string& pName, const size_t pIdx)
     {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-      if (dataRowIdx < mData.size())
+      // keep the load factor at or below one half
+      if (((mNames.size() + 1) * 2) > mSlots.size())
       {
-        mData.erase(mData.begin() + static_cast<std::ptrdiff_t>(dataRowIdx));
+        Rehash((mNames.size() + 1) * 2);
       }
-      else
+
+      const size_t hash = Hash(pName.data(), pName.size());
+      const size_t slot = FindSlot(pName.data(), pName.size(), hash);
+      if (mSlots[slot] == 0)
       {
-        const std::string errStr = "row out of range: " +
-          std::to_string(pRowIdx);
-        throw std::out_of_range(errStr);
+        mNames.push_back(pName);
+        mIndices.push_back(pIdx);
+        mHashes.push_back(hash);
+        mCounts.push_back(1);
+        mSlots[slot] = mNames.size();
       }
 
-      UpdateRowNames();
+      return mSlots[slot] - 1;
     }
 
-    /**
-     * @brief   Remove row by name.
-     * @param   pRowName              row label name.
-     */
-    void RemoveRow(const std::string& pRowName)
+    // FNV-1a, with the upper half folded into the lower bits used for the slot index.
+    static size_t Hash(const char* pName, const size_t pLength)
     {
-      int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+      uint64_t hash = 14695981039346656037ULL;
+      for (size_t i = 0; i < pLength; ++i)
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        hash ^= static_cast<unsigned char>(pName[i]);
+        hash *= 1099511628211ULL;
       }
 
-      RemoveRow(static_cast<size_t>(rowIdx));
+      return static_cast<size_t>(hash ^ (hash >> 32));
     }
 
-    /**
-     * @brief   Insert row at specified index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pRow                  vector of row data (optional argument).
-     * @param   pRowName              row label name (optional argument).
-     */
-    template<typename T>
-    void InsertRow(const size_t pRowIdx, const std::vector<T>& pRow = std::vector<T>(),
-                   const std::string& pRowName = std::string())
+    // Returns the slot referring to the name, or the empty slot ending its probe sequence.
+    size_t FindSlot(const char* pName, const size_t pLength, const size_t pHash) const
     {
-      const size_t rowIdx = GetDataRowIndex(pRowIdx);
-
-      std::vector<std::string> row;
-      if (pRow.empty())
-      {
-        row.resize(GetDataColumnCount());
-      }
-      else
+      const size_t mask = mSlots.size() - 1;
+      size_t slot = pHash & mask;
+      while (mSlots[slot] != 0)
       {
-        row.resize(GetDataColumnIndex(pRow.size()));
-        Converter<T> converter(mConverterParams);
-        for (auto itCol = pRow.begin(); itCol != pRow.end(); ++itCol)
+        const size_t pos = mSlots[slot] - 1;
+        if ((mHashes[pos] == pHash) && (mNames[pos].compare(0, std::string::npos, pName, pLength) == 0))
         {
-          std::string str;
-          converter.ToStr(*itCol, str);
-          row.at(static_cast<size_t>(std::distance(pRow.begin(), itCol) + mLabelParams.mRowNameIdx + 1)) = str;
+          return slot;
         }
+
+        slot = (slot + 1) & mask;
       }
 
-      while (rowIdx > GetDataRowCount())
+      return slot;
+    }
+
+    void Rehash(const size_t pMinCapacity)
+    {
+      size_t capacity = 16;
+      while (capacity < pMinCapacity)
       {
-        std::vector<std::string> tempRow;
-        tempRow.resize(GetDataColumnCount());
-        mData.push_back(tempRow);
+        capacity *= 2;
       }
 
-      mData.insert(mData.begin() + static_cast<std::ptrdiff_t>(rowIdx), row);
-
-      if (!pRowName.empty())
+      const size_t mask = capacity - 1;
+      mSlots.assign(capacity, 0);
+      for (size_t pos = 0; pos < mNames.size(); ++pos)
       {
-        SetRowName(pRowIdx, pRowName);
+        size_t slot = mHashes[pos] & mask;
+        while (mSlots[slot] != 0)
+        {
+          slot = (slot + 1) & mask;
+        }
+
+        mSlots[slot] = pos + 1;
       }
+    }
 
-      UpdateRowNames();
+    std::vector<std::string> mNames;
+    std::vector<size_t> mIndices;
+    std::vector<size_t> mHashes;
+
+    // number of labels sharing the name
+    std::vector<size_t> mCounts;
+
+    // zero for empty slots, otherwise one plus the position of the name
+    std::vector<size_t> mSlots;
+  };
+
+  /**
+   * @brief     Class storing cells column by column, keeping the cells of each column contiguous.
+   *            Rows shorter than the widest row are padded with empty cells which are not visible
+   *            through the row accessors. Columns may be dictionary encoded, storing a code per
+   *            cell referring to a dictionary of distinct values, and are decoded upon
+   *            modification. Only intended for rapidcsv internal usage.
+   */
+  class ColumnStore
+  {
+  public:
+    /**
+     * @brief   Constructor
+     */
+    ColumnStore()
+      : mColumns()
+      , mRowSizes()
+      , mDictionaries()
+    {
+    }
+
+    /**
+     * @brief   Reserve capacity for rows, in existing columns as well as columns added later.
+     * @param   pRowCount             number of rows expected to be stored.
+     */
+    void ReserveRows(const size_t pRowCount)
+    {
+      mRowSizes.reserve(pRowCount);
+      for (size_t columnIdx = 0; columnIdx < mColumns.size(); ++columnIdx)
+      {
+        if (IsEncoded(columnIdx))
+        {
+          mDictionaries[columnIdx].mCodes.reserve(pRowCount);
+        }
+        else
+        {
+          mColumns[columnIdx].reserve(pRowCount);
+        }
+      }
+    }
+
+    /**
+     * @brief   Reserve capacity for columns.
+     * @param   pColumnCount          number of columns expected to be stored.
+     */
+    void ReserveColumns(const size_t pColumnCount)
+    {
+      mColumns.reserve(pColumnCount);
+    }
+
+    /**
+     * @brief   Append row.
+     * @param   pRow                  vector of row cells.
+     */
+    void AppendRow(const std::vector<std::string>& pRow)
+    {
+      if (pRow.size() > mColumns.size())
+      {
+        const size_t columnCount = mColumns.size();
+        mColumns.resize(pRow.size(), std::vector<std::string>(GetRowCount()));
+        for (size_t columnIdx = columnCount; columnIdx < mColumns.size(); ++columnIdx)
+        {
+          mColumns[columnIdx].reserve(mRowSizes.capacity());
+        }
+      }
+
+      const std::string emptyCell;
+      for (size_t columnIdx = 0; columnIdx < mColumns.size(); ++columnIdx)
+      {
+        const std::string& cell = (columnIdx < pRow.size()) ? pRow[columnIdx] : emptyCell;
+        if (IsEncoded(columnIdx))
+        {
+          mDictionaries[columnIdx].Append(cell);
+        }
+        else
+        {
+          mColumns[columnIdx].push_back(cell);
+        }
+      }
+      mRowSizes.push_back(pRow.size());
+    }
+
+    /**
+     * @brief   Get number of rows.
+     * @returns row count.
+     */
+    size_t GetRowCount() const
+    {
+      return mRowSizes.size();
+    }
+
+    /**
+     * @brief   Get number of cells on row.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell count.
+     */
+    size_t GetRowSize(const size_t pRowIdx) const
+    {
+      CheckRowIdx(pRowIdx);
+      return mRowSizes[pRowIdx];
+    }
+
+    /**
+     * @brief   Get cell.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns cell reference.
+     */
+    const std::string& GetCell(const size_t pRowIdx, const size_t pColumnIdx) const
+    {
+      CheckCellIdx(pRowIdx, pColumnIdx);
+
+      // encoded columns only store the cells preceding their first encoded row
+      const std::vector<std::string>& column = mColumns[pColumnIdx];
+      if (pRowIdx < column.size())
+      {
+        return column[pRowIdx];
+      }
+
+      const Dictionary& dictionary = mDictionaries[pColumnIdx];
+      return dictionary.mValues[dictionary.mCodes[pRowIdx - column.size()]];
+    }
+
+    /**
+     * @brief   Get modifiable cell.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns cell reference.
+     */
+    std::string& GetCell(const size_t pRowIdx, const size_t pColumnIdx)
+    {
+      CheckCellIdx(pRowIdx, pColumnIdx);
+      if (pRowIdx >= mColumns[pColumnIdx].size())
+      {
+        Decode(pColumnIdx);
+      }
+
+      return mColumns[pColumnIdx][pRowIdx];
+    }
+
+    /**
+     * @brief   Resize row, adding empty cells or dropping cells at the end of it.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pSize                 new cell count.
+     */
+    void ResizeRow(const size_t pRowIdx, const size_t pSize)
+    {
+      CheckRowIdx(pRowIdx);
+      DecodeAll();
+      if (pSize > mColumns.size())
+      {
+        mColumns.resize(pSize, std::vector<std::string>(GetRowCount()));
+      }
+
+      for (size_t columnIdx = pSize; columnIdx < mRowSizes[pRowIdx]; ++columnIdx)
+      {
+        mColumns[columnIdx][pRowIdx].clear();
+      }
+      mRowSizes[pRowIdx] = pSize;
+    }
+
+    /**
+     * @brief   Remove column cell from all rows starting at specified row. Each of the rows must
+     *          hold the column.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pFirstRowIdx          zero-based index of first row to remove cell from.
+     */
+    void EraseColumn(const size_t pColumnIdx, const size_t pFirstRowIdx)
+    {
+      if ((pFirstRowIdx == 0) && IsRectangular())
+      {
+        mColumns.erase(mColumns.begin() + static_cast<std::ptrdiff_t>(pColumnIdx));
+        if (pColumnIdx < mDictionaries.size())
+        {
+          mDictionaries.erase(mDictionaries.begin() + static_cast<std::ptrdiff_t>(pColumnIdx));
+        }
+        for (size_t& rowSize : mRowSizes)
+        {
+          --rowSize;
+        }
+        return;
+      }
+
+      DecodeAll();
+      for (size_t rowIdx = pFirstRowIdx; rowIdx < GetRowCount(); ++rowIdx)
+      {
+        const size_t rowSize = mRowSizes[rowIdx];
+        for (size_t columnIdx = pColumnIdx; (columnIdx + 1) < rowSize; ++columnIdx)
+        {
+          mColumns[columnIdx][rowIdx].swap(mColumns[columnIdx + 1][rowIdx]);
+        }
+        mColumns[rowSize - 1][rowIdx].clear();
+        mRowSizes[rowIdx] = rowSize - 1;
+      }
+    }
+
+    /**
+     * @brief   Insert column cell in all rows starting at specified row. Each of the rows must
+     *          hold at least pColumnIdx cells.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pFirstRowIdx          zero-based index of first row to insert cell in.
+     * @param   pColumn               vector of cells indexed by row, moved from.
+     */
+    void InsertColumn(const size_t pColumnIdx, const size_t pFirstRowIdx, std::vector<std::string>& pColumn)
+    {
+      if ((pFirstRowIdx == 0) && (pColumn.size() == GetRowCount()) && IsRectangular())
+      {
+        mColumns.insert(mColumns.begin() + static_cast<std::ptrdiff_t>(pColumnIdx), std::vector<std::string>());
+        mColumns[pColumnIdx].swap(pColumn);
+        if (pColumnIdx < mDictionaries.size())
+        {
+          mDictionaries.insert(mDictionaries.begin() + static_cast<std::ptrdiff_t>(pColumnIdx), Dictionary());
+        }
+        for (size_t& rowSize : mRowSizes)
+        {
+          ++rowSize;
+        }
+        return;
+      }
+
+      DecodeAll();
+      for (size_t rowIdx = pFirstRowIdx; rowIdx < GetRowCount(); ++rowIdx)
+      {
+        std::string& cell = pColumn.at(rowIdx);
+        const size_t rowSize = mRowSizes[rowIdx];
+        if ((rowSize + 1) > mColumns.size())
+        {
+          mColumns.resize(rowSize + 1, std::vector<std::string>(GetRowCount()));
+        }
+
+        for (size_t columnIdx = rowSize; columnIdx > pColumnIdx; --columnIdx)
+        {
+          mColumns[columnIdx][rowIdx].swap(mColumns[columnIdx - 1][rowIdx]);
+        }
+        mColumns[pColumnIdx][rowIdx].swap(cell);
+        mRowSizes[rowIdx] = rowSize + 1;
+      }
+    }
+
+    /**
+     * @brief   Get number of cells with memory allocated per cell.
+     * @returns cell allocation count.
+     */
+    size_t GetCellAllocationCount() const
+    {
+      const size_t inlineCapacity = std::string().capacity();
+      size_t cellAllocationCount = 0;
+      for (const std::vector<std::string>& column : mColumns)
+      {
+        for (const std::string& cell : column)
+        {
+          if (cell.capacity() > inlineCapacity)
+          {
+            ++cellAllocationCount;
+          }
+        }
+      }
+      for (const Dictionary& dictionary : mDictionaries)
+      {
+        for (const std::string& value : dictionary.mValues)
+        {
+          if (value.capacity() > inlineCapacity)
+          {
+            ++cellAllocationCount;
+          }
+        }
+      }
+      return cellAllocationCount;
+    }
+
+    /**
+     * @brief   Dictionary encode column, from specified row onwards, unless it holds more distinct
+     *          values than specified.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pFirstRowIdx          zero-based index of first row to encode.
+     * @param   pMaxDictionarySize    maximum number of distinct values.
+     * @returns true if the column is encoded.
+     */
+    bool Encode(const size_t pColumnIdx, const size_t pFirstRowIdx, const size_t pMaxDictionarySize)
+    {
+      if (IsEncoded(pColumnIdx) || (pFirstRowIdx > GetRowCount()))
+      {
+        return IsEncoded(pColumnIdx);
+      }
+
+      std::vector<std::string>& column = mColumns.at(pColumnIdx);
+      Dictionary dictionary;
+      dictionary.mCodes.reserve(column.size() - pFirstRowIdx);
+      for (size_t rowIdx = pFirstRowIdx; rowIdx < column.size(); ++rowIdx)
+      {
+        dictionary.Append(column[rowIdx]);
+        if (dictionary.mValues.size() > pMaxDictionarySize)
+        {
+          return false;
+        }
+      }
+
+      if (pColumnIdx >= mDictionaries.size())
+      {
+        mDictionaries.resize(pColumnIdx + 1);
+      }
+
+      dictionary.mEncoded = true;
+      mDictionaries[pColumnIdx] = std::move(dictionary);
+      column.resize(pFirstRowIdx);
+      column.shrink_to_fit();
+      return true;
+    }
+
+    /**
+     * @brief   Get whether column is dictionary encoded.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns true if the column is encoded.
+     */
+    bool IsEncoded(const size_t pColumnIdx) const
+    {
+      return (pColumnIdx < mDictionaries.size()) && mDictionaries[pColumnIdx].mEncoded;
+    }
+
+    /**
+     * @brief   Get distinct values of dictionary encoded column, indexed by code.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns dictionary reference.
+     */
+    const std::vector<std::string>& GetDictionary(const size_t pColumnIdx) const
+    {
+      CheckEncoded(pColumnIdx);
+      return mDictionaries[pColumnIdx].mValues;
+    }
+
+    /**
+     * @brief   Get codes of dictionary encoded column, starting at its first encoded row.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns codes reference.
+     */
+    const std::vector<uint32_t>& GetCodes(const size_t pColumnIdx) const
+    {
+      CheckEncoded(pColumnIdx);
+      return mDictionaries[pColumnIdx].mCodes;
+    }
+
+    /**
+     * @brief   Clears all rows and releases the column memory.
+     */
+    void Clear()
+    {
+      std::vector<std::vector<std::string>>().swap(mColumns);
+      std::vector<size_t>().swap(mRowSizes);
+      std::vector<Dictionary>().swap(mDictionaries);
+    }
+
+  private:
+    struct Dictionary
+    {
+      Dictionary()
+        : mEncoded(false)
+        , mValues()
+        , mCodes()
+        , mCodeIndex()
+      {
+      }
+
+      void Append(const std::string& pCell)
+      {
+        size_t code = 0;
+        if (!mCodeIndex.Find(pCell.data(), pCell.size(), code))
+        {
+          code = mValues.size();
+          mCodeIndex.Set(pCell, code);
+          mValues.push_back(pCell);
+        }
+
+        mCodes.push_back(static_cast<uint32_t>(code));
+      }
+
+      bool mEncoded;
+      std::vector<std::string> mValues;
+      std::vector<uint32_t> mCodes;
+      LabelIndex mCodeIndex;
+    };
+
+    void Decode(const size_t pColumnIdx)
+    {
+      if (!IsEncoded(pColumnIdx))
+      {
+        return;
+      }
+
+      Dictionary& dictionary = mDictionaries[pColumnIdx];
+      std::vector<std::string>& column = mColumns[pColumnIdx];
+      column.reserve(column.size() + dictionary.mCodes.size());
+      for (const uint32_t code : dictionary.mCodes)
+      {
+        column.push_back(dictionary.mValues[code]);
+      }
+      dictionary = Dictionary();
+    }
+
+    void DecodeAll()
+    {
+      for (size_t columnIdx = 0; columnIdx < mDictionaries.size(); ++columnIdx)
+      {
+        Decode(columnIdx);
+      }
+      std::vector<Dictionary>().swap(mDictionaries);
+    }
+
+    void CheckEncoded(const size_t pColumnIdx) const
+    {
+      if (!IsEncoded(pColumnIdx))
+      {
+        throw std::out_of_range("column store column index " + std::to_string(pColumnIdx) + " not encoded");
+      }
+    }
+
+    bool IsRectangular() const
+    {
+      for (const size_t rowSize : mRowSizes)
+      {
+        if (rowSize != mColumns.size())
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    void CheckRowIdx(const size_t pRowIdx) const
+    {
+      if (pRowIdx >= GetRowCount())
+      {
+        throw std::out_of_range("column store row index " + std::to_string(pRowIdx) + " >= " +
+                                std::to_string(GetRowCount()));
+      }
+    }
+
+    void CheckCellIdx(const size_t pRowIdx, const size_t pColumnIdx) const
+    {
+      if (pColumnIdx >= GetRowSize(pRowIdx))
+      {
+        throw std::out_of_range("column store column index " + std::to_string(pColumnIdx) + " >= " +
+                                std::to_string(GetRowSize(pRowIdx)));
+      }
+    }
+
+    std::vector<std::vector<std::string>> mColumns;
+    std::vector<size_t> mRowSizes;
+
+    // indexed by column, only covering columns up to the last encoded one
+    std::vector<Dictionary> mDictionaries;
+  };
+
+#if defined(RAPIDCSV_HAS_MMAP)
+  /**
+   * @brief     Class providing a read-only memory mapping of a file. Only intended for rapidcsv
+   *            internal usage.
+   */
+  class MappedFile
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing file to map.
+     */
+    explicit MappedFile(const std::string& pPath)
+      : mData(nullptr)
+      , mSize(0)
+    {
+      const int fd = open(pPath.c_str(), O_RDONLY);
+      if (fd == -1)
+      {
+        ThrowError("open failed: " + pPath);
+      }
+
+      struct stat st;
+      if (fstat(fd, &st) == -1)
+      {
+        const int err = errno;
+        close(fd);
+        errno = err;
+        ThrowError("fstat failed: " + pPath);
+      }
+
+      mSize = static_cast<size_t>(st.st_size);
+      if (mSize > 0)
+      {
+        void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+          const int err = errno;
+          close(fd);
+          errno = err;
+          ThrowError("mmap failed: " + pPath);
+        }
+
+        madvise(data, mSize, MADV_SEQUENTIAL);
+        mData = static_cast<const char*>(data);
+      }
+
+      // the mapping remains valid after closing the file descriptor
+      close(fd);
+    }
+
+    ~MappedFile()
+    {
+      if (mData != nullptr)
+      {
+        munmap(const_cast<char*>(mData), mSize);
+      }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief   Get mapped file data.
+     * @returns pointer to mapped data, or nullptr for an empty file.
+     */
+    const char* GetData() const
+    {
+      return mData;
+    }
+
+    /**
+     * @brief   Get mapped file size.
+     * @returns size in bytes.
+     */
+    size_t GetSize() const
+    {
+      return mSize;
+    }
+
+  private:
+    static void ThrowError(const std::string& pMessage)
+    {
+      throw std::ios_base::failure(pMessage, std::error_code(errno, std::generic_category()));
+    }
+
+    const char* mData;
+    size_t mSize;
+  };
+#endif
+
+  class Document;
+
+  /**
+   * @brief     Class representing a column of a Document resolved by Document::GetColumnRef(),
+   *            allowing repeated cell access without looking up the column name. A reference is
+   *            only valid for the Document instance it was obtained from, and is invalidated by
+   *            insertion or removal of columns, and by clearing or loading the Document. Copies
+   *            of the Document do not accept it. Default constructed references are invalid.
+   */
+  class ColumnRef
+  {
+  public:
+    /**
+     * @brief   Constructor
+     */
+    ColumnRef()
+      : mDocument(nullptr)
+      , mDataColumnIdx(0)
+      , mGeneration(0)
+    {
+    }
+
+  private:
+    friend class Document;
+
+    ColumnRef(const Document* pDocument, const size_t pDataColumnIdx, const size_t pGeneration)
+      : mDocument(pDocument)
+      , mDataColumnIdx(pDataColumnIdx)
+      , mGeneration(pGeneration)
+    {
+    }
+
+    const Document* mDocument;
+    size_t mDataColumnIdx;
+    size_t mGeneration;
+  };
+
+  /**
+   * @brief     Class representing a row of a Document resolved by Document::GetRowRef(),
+   *            allowing repeated cell access without looking up the row name. A reference is
+   *            only valid for the Document instance it was obtained from, and is invalidated by
+   *            insertion or removal of rows, and by clearing or loading the Document. Copies of
+   *            the Document do not accept it. Default constructed references are invalid.
+   */
+  class RowRef
+  {
+  public:
+    /**
+     * @brief   Constructor
+     */
+    RowRef()
+      : mDocument(nullptr)
+      , mDataRowIdx(0)
+      , mGeneration(0)
+    {
+    }
+
+  private:
+    friend class Document;
+
+    RowRef(const Document* pDocument, const size_t pDataRowIdx, const size_t pGeneration)
+      : mDocument(pDocument)
+      , mDataRowIdx(pDataRowIdx)
+      , mGeneration(pGeneration)
+    {
+    }
+
+    const Document* mDocument;
+    size_t mDataRowIdx;
+    size_t mGeneration;
+  };
+
+  /**
+   * @brief     Class representing a CSV document.
+   */
+  class Document
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
+     *                                data with.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pLoadParams           specifies how the CSV data should be loaded.
+     * @param   pStorageParams        specifies how the Document data should be stored.
+     */
+    explicit Document(const std::string& pPath = std::string(),
+                      const LabelParams& pLabelParams = LabelParams(),
+                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                      const ConverterParams& pConverterParams = ConverterParams(),
+                      const LineReaderParams& pLineReaderParams = LineReaderParams(),
+                      const LoadParams& pLoadParams = LoadParams(),
+                      const StorageParams& pStorageParams = StorageParams())
+      : mPath(pPath)
+      , mLabelParams(pLabelParams)
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mLineReaderParams(pLineReaderParams)
+      , mLoadParams(pLoadParams)
+      , mStorageParams(pStorageParams)
+      , mLayout(pStorageParams.mLayout)
+      , mData()
+      , mCellBuffer()
+      , mColumnStore()
+      , mColumnNames()
+      , mRowNames()
+      , mProjectedFields()
+      , mPendingRows()
+      , mColumnCache()
+    {
+      if (!mPath.empty())
+      {
+        ReadCsv();
+      }
+    }
+
+    /**
+     * @brief   Constructor
+     * @param   pStream               specifies a binary input stream to read CSV data from.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pLoadParams           specifies how the CSV data should be loaded.
+     * @param   pStorageParams        specifies how the Document data should be stored.
+     */
+    explicit Document(std::istream& pStream,
+                      const LabelParams& pLabelParams = LabelParams(),
+                      const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                      const ConverterParams& pConverterParams = ConverterParams(),
+                      const LineReaderParams& pLineReaderParams = LineReaderParams(),
+                      const LoadParams& pLoadParams = LoadParams(),
+                      const StorageParams& pStorageParams = StorageParams())
+      : mPath()
+      , mLabelParams(pLabelParams)
+      , mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mLineReaderParams(pLineReaderParams)
+      , mLoadParams(pLoadParams)
+      , mStorageParams(pStorageParams)
+      , mLayout(pStorageParams.mLayout)
+      , mData()
+      , mCellBuffer()
+      , mColumnStore()
+      , mColumnNames()
+      , mRowNames()
+      , mProjectedFields()
+      , mPendingRows()
+      , mColumnCache()
+    {
+      ReadCsv(pStream);
+    }
+
+    /**
+     * @brief   Read Document data from file.
+     * @param   pPath                 specifies the path of an existing CSV-file to populate the Document
+     *                                data with.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pLoadParams           specifies how the CSV data should be loaded.
+     * @param   pStorageParams        specifies how the Document data should be stored.
+     */
+    void Load(const std::string& pPath,
+              const LabelParams& pLabelParams = LabelParams(),
+              const SeparatorParams& pSeparatorParams = SeparatorParams(),
+              const ConverterParams& pConverterParams = ConverterParams(),
+              const LineReaderParams& pLineReaderParams = LineReaderParams(),
+              const LoadParams& pLoadParams = LoadParams(),
+              const StorageParams& pStorageParams = StorageParams())
+    {
+      mPath = pPath;
+      mLabelParams = pLabelParams;
+      mSeparatorParams = pSeparatorParams;
+      mConverterParams = pConverterParams;
+      mLineReaderParams = pLineReaderParams;
+      mLoadParams = pLoadParams;
+      mStorageParams = pStorageParams;
+      ReadCsv();
+    }
+
+    /**
+     * @brief   Read Document data from stream.
+     * @param   pStream               specifies a binary input stream to read CSV data from.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pLoadParams           specifies how the CSV data should be loaded.
+     * @param   pStorageParams        specifies how the Document data should be stored.
+     */
+    void Load(std::istream& pStream,
+              const LabelParams& pLabelParams = LabelParams(),
+              const SeparatorParams& pSeparatorParams = SeparatorParams(),
+              const ConverterParams& pConverterParams = ConverterParams(),
+              const LineReaderParams& pLineReaderParams = LineReaderParams(),
+              const LoadParams& pLoadParams = LoadParams(),
+              const StorageParams& pStorageParams = StorageParams())
+    {
+      mPath = "";
+      mLabelParams = pLabelParams;
+      mSeparatorParams = pSeparatorParams;
+      mConverterParams = pConverterParams;
+      mLineReaderParams = pLineReaderParams;
+      mLoadParams = pLoadParams;
+      mStorageParams = pStorageParams;
+      ReadCsv(pStream);
+    }
+
+    /**
+     * @brief   Write Document data to file.
+     * @param   pPath                 optionally specifies the path where the CSV-file will be created
+     *                                (if not specified, the original path provided when creating or
+     *                                loading the Document data will be used).
+     */
+    void Save(const std::string& pPath = std::string())
+    {
+      if (!pPath.empty())
+      {
+        mPath = pPath;
+      }
+      WriteCsv();
+    }
+
+    /**
+     * @brief   Write Document data to stream.
+     * @param   pStream               specifies a binary output stream to write the data to.
+     */
+    void Save(std::ostream& pStream) const
+    {
+      WriteCsv(pStream);
+    }
+
+    /**
+     * @brief   Write Document data to a binary snapshot file, which LoadSnapshot() reads
+     *          considerably faster than CSV data. The snapshot holds all cells including labels,
+     *          along with the label and separator parameters and encoding of the CSV data. It uses
+     *          the native byte order, and is not intended to be portable between platforms.
+     * @param   pPath                 specifies the path where the snapshot file will be created.
+     */
+    void SaveSnapshot(const std::string& pPath) const
+    {
+      std::ofstream stream;
+      stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+      stream.open(pPath, std::ios::binary | std::ios::trunc);
+      WriteSnapshot(stream);
+    }
+
+    /**
+     * @brief   Read Document data from a snapshot file created by SaveSnapshot(). The label and
+     *          separator parameters, encoding and path of the saved Document are restored.
+     * @param   pPath                 specifies the path of an existing snapshot file.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pStorageParams        specifies how the Document data should be stored. Using the
+     *                                buffer layout, the cell data is copied in bulk rather than
+     *                                cell by cell.
+     */
+    void LoadSnapshot(const std::string& pPath,
+                      const ConverterParams& pConverterParams = ConverterParams(),
+                      const StorageParams& pStorageParams = StorageParams())
+    {
+      mConverterParams = pConverterParams;
+      mStorageParams = pStorageParams;
+#if defined(RAPIDCSV_HAS_MMAP)
+      const MappedFile file(pPath);
+      ReadSnapshot(pPath, file.GetData(), file.GetSize());
+#else
+      std::ifstream stream;
+      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      stream.open(pPath, std::ios::binary | std::ios::ate);
+      const std::streamsize length = stream.tellg();
+      stream.seekg(0, std::ios::beg);
+
+      // read into 64-bit units, keeping the offset arrays aligned
+      std::vector<uint64_t> data((static_cast<size_t>(length) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+      stream.read(reinterpret_cast<char*>(data.data()), length);
+      ReadSnapshot(pPath, reinterpret_cast<const char*>(data.data()), static_cast<size_t>(length));
+#endif
+    }
+
+    /**
+     * @brief   Clears loaded Document data.
+     *
+     */
+    void Clear()
+    {
+      mColumnGeneration = NextGeneration();
+      mRowGeneration = NextGeneration();
+      mData.clear();
+      mCellBuffer.Clear();
+      mColumnStore.Clear();
+      mLayout = mStorageParams.mLayout;
+      mColumnNames.Clear();
+      mRowNames.Clear();
+      InvalidateColumnCache();
+      mIsUtf16 = false;
+      mIsLE = false;
+      mHasUtf8BOM = false;
+    }
+
+    /**
+     * @brief   Get column index by name. The result is undefined if the document contains
+     *          multiple columns sharing the same label name. Column indices exceeding
+     *          INT_MAX are not supported.
+     * @param   pColumnName           column label name.
+     * @returns zero-based column index.
+     */
+    int GetColumnIdx(const std::string& pColumnName) const
+    {
+      return FindColumnIdx(pColumnName.data(), pColumnName.size());
+    }
+
+    /**
+     * @brief   Get column index by name. The result is undefined if the document contains
+     *          multiple columns sharing the same label name. Column indices exceeding
+     *          INT_MAX are not supported.
+     * @param   pColumnName           column label name, null-terminated.
+     * @returns zero-based column index.
+     */
+    int GetColumnIdx(const char* pColumnName) const
+    {
+      return FindColumnIdx(pColumnName, strlen(pColumnName));
+    }
+
+#if defined(RAPIDCSV_HAS_STRING_VIEW)
+    /**
+     * @brief   Get column index by name. The result is undefined if the document contains
+     *          multiple columns sharing the same label name. Column indices exceeding
+     *          INT_MAX are not supported.
+     * @param   pColumnName           column label name.
+     * @returns zero-based column index.
+     */
+    int GetColumnIdx(const std::string_view pColumnName) const
+    {
+      return FindColumnIdx(pColumnName.data(), pColumnName.size());
+    }
+#endif
+
+    /**
+     * @brief   Get column by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const size_t pColumnIdx) const
+    {
+      if (mStorageParams.mColumnCache)
+      {
+        return GetCachedColumn<T>(pColumnIdx);
+      }
+
+      std::vector<T> column;
+      column.reserve(GetRowCount());
+      ConvertColumn<T>(pColumnIdx, std::back_inserter(column));
+      return column;
+    }
+
+    /**
+     * @brief   Get column by index into a caller-provided vector, reusing its capacity.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector replaced with the column data.
+     */
+    template<typename T>
+    void GetColumn(const size_t pColumnIdx, std::vector<T>& pColumn) const
+    {
+      if (mStorageParams.mColumnCache)
+      {
+        const std::vector<T>& column = GetCachedColumn<T>(pColumnIdx);
+        pColumn.assign(column.begin(), column.end());
+        return;
+      }
+
+      pColumn.clear();
+      pColumn.reserve(GetRowCount());
+      ConvertColumn<T>(pColumnIdx, std::back_inserter(pColumn));
+    }
+
+    /**
+     * @brief   Get column by index into a caller-provided array.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               array receiving the column data.
+     * @param   pSize                 number of elements available in pColumn, which must be no less
+     *                                than the number of rows.
+     * @returns number of elements written to pColumn.
+     */
+    template<typename T>
+    size_t GetColumn(const size_t pColumnIdx, T* pColumn, const size_t pSize) const
+    {
+      const size_t columnSize = GetRowCount();
+      CheckOutputSize(columnSize, pSize);
+      if (mStorageParams.mColumnCache)
+      {
+        const std::vector<T>& column = GetCachedColumn<T>(pColumnIdx);
+        std::copy(column.begin(), column.end(), pColumn);
+        return columnSize;
+      }
+
+      ConvertColumn<T>(pColumnIdx, pColumn);
+      return columnSize;
+    }
+
+    /**
+     * @brief   Get number of GetColumn() calls served by the column cache, see
+     *          StorageParams::mColumnCache.
+     * @returns column cache hit count.
+     */
+    size_t GetColumnCacheHits() const
+    {
+      return mColumnCacheHits;
+    }
+
+    /**
+     * @brief   Get number of GetColumn() calls which converted and added a column to the column
+     *          cache, see StorageParams::mColumnCache.
+     * @returns column cache miss count.
+     */
+    size_t GetColumnCacheMisses() const
+    {
+      return mColumnCacheMisses;
+    }
+
+    /**
+     * @brief   Remove all columns from the column cache, releasing their memory.
+     */
+    void ClearColumnCache()
+    {
+      InvalidateColumnCache();
+    }
+
+    /**
+     * @brief   Get whether column is dictionary encoded, see StorageParams::mDictionaryColumns.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns true if the column is dictionary encoded.
+     */
+    bool IsColumnDictionaryEncoded(const size_t pColumnIdx) const
+    {
+      return (mLayout == StorageLayout::ColumnMajor) && mColumnStore.IsEncoded(GetDataColumnIndex(pColumnIdx));
+    }
+
+    /**
+     * @brief   Get whether column is dictionary encoded, see StorageParams::mDictionaryColumns.
+     * @param   pColumnName           column label name.
+     * @returns true if the column is dictionary encoded.
+     */
+    bool IsColumnDictionaryEncoded(const std::string& pColumnName) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return IsColumnDictionaryEncoded(static_cast<size_t>(columnIdx));
+    }
+
+    /**
+     * @brief   Get distinct values of dictionary encoded column, indexed by the codes returned by
+     *          GetColumnCodes(). The reference is valid until the document is modified.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns reference to vector of distinct values.
+     */
+    const std::vector<std::string>& GetColumnDictionary(const size_t pColumnIdx) const
+    {
+      CheckColumnDictionaryEncoded(pColumnIdx);
+      return mColumnStore.GetDictionary(GetDataColumnIndex(pColumnIdx));
+    }
+
+    /**
+     * @brief   Get distinct values of dictionary encoded column, indexed by the codes returned by
+     *          GetColumnCodes(). The reference is valid until the document is modified.
+     * @param   pColumnName           column label name.
+     * @returns reference to vector of distinct values.
+     */
+    const std::vector<std::string>& GetColumnDictionary(const std::string& pColumnName) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumnDictionary(static_cast<size_t>(columnIdx));
+    }
+
+    /**
+     * @brief   Get codes of dictionary encoded column, one per row, allowing for example
+     *          filtering and grouping of rows by comparing integers. Rows not holding the column
+     *          have the code of an empty cell. The reference is valid until the document is
+     *          modified.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns reference to vector of codes.
+     */
+    const std::vector<uint32_t>& GetColumnCodes(const size_t pColumnIdx) const
+    {
+      CheckColumnDictionaryEncoded(pColumnIdx);
+      return mColumnStore.GetCodes(GetDataColumnIndex(pColumnIdx));
+    }
+
+    /**
+     * @brief   Get codes of dictionary encoded column, one per row, allowing for example
+     *          filtering and grouping of rows by comparing integers. Rows not holding the column
+     *          have the code of an empty cell. The reference is valid until the document is
+     *          modified.
+     * @param   pColumnName           column label name.
+     * @returns reference to vector of codes.
+     */
+    const std::vector<uint32_t>& GetColumnCodes(const std::string& pColumnName) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumnCodes(static_cast<size_t>(columnIdx));
+    }
+
+    /**
+     * @brief   Get column by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pToVal                conversion function.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const size_t pColumnIdx, ConvFunc<T> pToVal) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      std::vector<T> column;
+      column.reserve(GetRowCount());
+      std::string cell;
+      for (size_t dataRowIdx = GetDataRowIndex(0); dataRowIdx < GetDataRowCount(); ++dataRowIdx)
+      {
+        T val;
+        pToVal(GetDataCell(dataRowIdx, dataColumnIdx, cell), val);
+        column.push_back(val);
+      }
+      return column;
+    }
+
+    /**
+     * @brief   Get column by name.
+     * @param   pColumnName           column label name.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const std::string& pColumnName) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumn<T>(static_cast<size_t>(columnIdx));
+    }
+
+    /**
+     * @brief   Get column by name into a caller-provided vector, reusing its capacity.
+     * @param   pColumnName           column label name.
+     * @param   pColumn               vector replaced with the column data.
+     */
+    template<typename T>
+    void GetColumn(const std::string& pColumnName, std::vector<T>& pColumn) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      GetColumn<T>(static_cast<size_t>(columnIdx), pColumn);
+    }
+
+    /**
+     * @brief   Get column by name into a caller-provided array.
+     * @param   pColumnName           column label name.
+     * @param   pColumn               array receiving the column data.
+     * @param   pSize                 number of elements available in pColumn, which must be no less
+     *                                than the number of rows.
+     * @returns number of elements written to pColumn.
+     */
+    template<typename T>
+    size_t GetColumn(const std::string& pColumnName, T* pColumn, const size_t pSize) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumn<T>(static_cast<size_t>(columnIdx), pColumn, pSize);
+    }
+
+    /**
+     * @brief   Get column by name.
+     * @param   pColumnName           column label name.
+     * @param   pToVal                conversion function.
+     * @returns vector of column data.
+     */
+    template<typename T>
+    std::vector<T> GetColumn(const std::string& pColumnName, ConvFunc<T> pToVal) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      return GetColumn<T>(static_cast<size_t>(columnIdx), pToVal);
+    }
+
+    /**
+     * @brief   Set column by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector of column data.
+     */
+    template<typename T>
+    void SetColumn(const size_t pColumnIdx, const std::vector<T>& pColumn)
+    {
+      SetColumnCells<T>(pColumnIdx, pColumn.begin(), pColumn.end());
+    }
+
+    /**
+     * @brief   Set column by index, moving the cells of a string column into the document.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector of column data.
+     */
+    template<typename T>
+    void SetColumn(const size_t pColumnIdx, std::vector<T>&& pColumn)
+    {
+      SetColumnCells<T>(pColumnIdx, std::make_move_iterator(pColumn.begin()), std::make_move_iterator(pColumn.end()));
+    }
+
+    /**
+     * @brief   Set column by name.
+     * @param   pColumnName           column label name.
+     * @param   pColumn               vector of column data.
+     */
+    template<typename T>
+    void SetColumn(const std::string& pColumnName, const std::vector<T>& pColumn)
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      SetColumn<T>(static_cast<size_t>(columnIdx), pColumn);
+    }
+
+    /**
+     * @brief   Set column by name, moving the cells of a string column into the document.
+     * @param   pColumnName           column label name.
+     * @param   pColumn               vector of column data.
+     */
+    template<typename T>
+    void SetColumn(const std::string& pColumnName, std::vector<T>&& pColumn)
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+      SetColumn<T>(static_cast<size_t>(columnIdx), std::move(pColumn));
+    }
+
+    /**
+     * @brief   Remove column by index.
+     * @param   pColumnIdx            zero-based column index.
+     */
+    void RemoveColumn(const size_t pColumnIdx)
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      for (size_t dataRowIdx = GetColumnNameRowIndex(); dataRowIdx < GetDataRowCount(); ++dataRowIdx)
+      {
+        if (dataColumnIdx >= GetDataRowSize(dataRowIdx))
+        {
+          const std::string errStr = "column out of range: " +
+            std::to_string(pColumnIdx) + " (on row " +
+            std::to_string(dataRowIdx) +
+            ")";
+          throw std::out_of_range(errStr);
+        }
+      }
+
+      mColumnGeneration = NextGeneration();
+      ConvertToColumnModifiable();
+      std::string columnName;
+      const bool hasColumnNames = HasColumnNames();
+      if (hasColumnNames)
+      {
+        columnName = GetDataCell(GetColumnNameRowIndex(), dataColumnIdx);
+      }
+
+      ShiftColumnCache(dataColumnIdx, -1);
+      if (mLayout == StorageLayout::ColumnMajor)
+      {
+        mColumnStore.EraseColumn(dataColumnIdx, GetColumnNameRowIndex());
+      }
+      else
+      {
+        for (auto itRow = mData.begin() + static_cast<std::ptrdiff_t>(GetColumnNameRowIndex());
+             itRow != mData.end(); ++itRow)
+        {
+          itRow->erase(itRow->begin() + static_cast<std::ptrdiff_t>(dataColumnIdx));
+        }
+      }
+
+      if (hasColumnNames && mColumnNames.Remove(columnName, dataColumnIdx))
+      {
+        ResetColumnName(columnName, dataColumnIdx);
+      }
+    }
+
+    /**
+     * @brief   Remove column by name.
+     * @param   pColumnName           column label name.
+     */
+    void RemoveColumn(const std::string& pColumnName)
+    {
+      int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      RemoveColumn(static_cast<size_t>(columnIdx));
+    }
+
+    /**
+     * @brief   Insert column at specified index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector of column data (optional argument).
+     * @param   pColumnName           column label name (optional argument).
+     */
+    template<typename T>
+    void InsertColumn(const size_t pColumnIdx, const std::vector<T>& pColumn = std::vector<T>(),
+                      const std::string& pColumnName = std::string())
+    {
+      InsertDataColumn(pColumnIdx, ToDataColumn<T>(pColumn.begin(), pColumn.end()), pColumnName);
+    }
+
+    /**
+     * @brief   Insert column at specified index, moving the cells of a string column into the
+     *          document.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumn               vector of column data.
+     * @param   pColumnName           column label name (optional argument).
+     */
+    template<typename T>
+    void InsertColumn(const size_t pColumnIdx, std::vector<T>&& pColumn, const std::string& pColumnName = std::string())
+    {
+      InsertDataColumn(pColumnIdx,
+                       ToDataColumn<T>(std::make_move_iterator(pColumn.begin()), std::make_move_iterator(pColumn.end())),
+                       pColumnName);
+    }
+
+    /**
+     * @brief   Get number of data columns (excluding label columns).
+     * @returns column count.
+     */
+    size_t GetColumnCount() const
+    {
+      const size_t firstRow = static_cast<size_t>((mLabelParams.mColumnNameIdx >= 0) ? mLabelParams.mColumnNameIdx : 0);
+      const std::ptrdiff_t count =
+        static_cast<std::ptrdiff_t>((GetDataRowCount() > firstRow) ? GetDataRowSize(firstRow) : 0) -
+        (mLabelParams.mRowNameIdx + 1);
+      return (count >= 0) ? static_cast<size_t>(count) : 0;
+    }
+
+    /**
+     * @brief   Get row index by name. The result is undefined if the document contains
+     *          multiple rows sharing the same label name. Row indices exceeding INT_MAX
+     *          are not supported.
+     * @param   pRowName              row label name.
+     * @returns zero-based row index.
+     */
+    int GetRowIdx(const std::string& pRowName) const
+    {
+      return FindRowIdx(pRowName.data(), pRowName.size());
+    }
+
+    /**
+     * @brief   Get row index by name. The result is undefined if the document contains
+     *          multiple rows sharing the same label name. Row indices exceeding INT_MAX
+     *          are not supported.
+     * @param   pRowName              row label name, null-terminated.
+     * @returns zero-based row index.
+     */
+    int GetRowIdx(const char* pRowName) const
+    {
+      return FindRowIdx(pRowName, strlen(pRowName));
+    }
+
+#if defined(RAPIDCSV_HAS_STRING_VIEW)
+    /**
+     * @brief   Get row index by name. The result is undefined if the document contains
+     *          multiple rows sharing the same label name. Row indices exceeding INT_MAX
+     *          are not supported.
+     * @param   pRowName              row label name.
+     * @returns zero-based row index.
+     */
+    int GetRowIdx(const std::string_view pRowName) const
+    {
+      return FindRowIdx(pRowName.data(), pRowName.size());
+    }
+#endif
+
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const size_t pRowIdx) const
+    {
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      std::vector<T> row;
+      row.reserve(GetRowCellCount(dataRowIdx));
+      ConvertRow<T>(dataRowIdx, std::back_inserter(row));
+      return row;
+    }
+
+    /**
+     * @brief   Get row by index into a caller-provided vector, reusing its capacity.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector replaced with the row data.
+     */
+    template<typename T>
+    void GetRow(const size_t pRowIdx, std::vector<T>& pRow) const
+    {
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      pRow.clear();
+      pRow.reserve(GetRowCellCount(dataRowIdx));
+      ConvertRow<T>(dataRowIdx, std::back_inserter(pRow));
+    }
+
+    /**
+     * @brief   Get row by index into a caller-provided array.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  array receiving the row data.
+     * @param   pSize                 number of elements available in pRow, which must be no less
+     *                                than the number of cells on the row.
+     * @returns number of elements written to pRow.
+     */
+    template<typename T>
+    size_t GetRow(const size_t pRowIdx, T* pRow, const size_t pSize) const
+    {
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      const size_t rowSize = GetRowCellCount(dataRowIdx);
+      CheckOutputSize(rowSize, pSize);
+      ConvertRow<T>(dataRowIdx, pRow);
+      return rowSize;
+    }
+
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      std::vector<T> row;
+      row.reserve(GetRowCellCount(dataRowIdx));
+      std::string cell;
+      const size_t rowSize = GetDataRowSize(dataRowIdx);
+      for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < rowSize; ++dataColumnIdx)
+      {
+        T val;
+        pToVal(GetDataCell(dataRowIdx, dataColumnIdx, cell), val);
+        row.push_back(val);
+      }
+      return row;
+    }
+
+    /**
+     * @brief   Get row by name.
+     * @param   pRowName              row label name.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const std::string& pRowName) const
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return GetRow<T>(static_cast<size_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Get row by name into a caller-provided vector, reusing its capacity.
+     * @param   pRowName              row label name.
+     * @param   pRow                  vector replaced with the row data.
+     */
+    template<typename T>
+    void GetRow(const std::string& pRowName, std::vector<T>& pRow) const
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      GetRow<T>(static_cast<size_t>(rowIdx), pRow);
+    }
+
+    /**
+     * @brief   Get row by name into a caller-provided array.
+     * @param   pRowName              row label name.
+     * @param   pRow                  array receiving the row data.
+     * @param   pSize                 number of elements available in pRow, which must be no less
+     *                                than the number of cells on the row.
+     * @returns number of elements written to pRow.
+     */
+    template<typename T>
+    size_t GetRow(const std::string& pRowName, T* pRow, const size_t pSize) const
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return GetRow<T>(static_cast<size_t>(rowIdx), pRow, pSize);
+    }
+
+    /**
+     * @brief   Get row by name.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns vector of row data.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return GetRow<T>(static_cast<size_t>(rowIdx), pToVal);
+    }
+
+    /**
+     * @brief   Set row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void SetRow(const size_t pRowIdx, const std::vector<T>& pRow)
+    {
+      SetRowCells<T>(pRowIdx, pRow.begin(), pRow.end());
+    }
+
+    /**
+     * @brief   Set row by index, moving the cells of a string row into the document.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void SetRow(const size_t pRowIdx, std::vector<T>&& pRow)
+    {
+      SetRowCells<T>(pRowIdx, std::make_move_iterator(pRow.begin()), std::make_move_iterator(pRow.end()));
+    }
+
+    /**
+     * @brief   Set row by name.
+     * @param   pRowName              row label name.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void SetRow(const std::string& pRowName, const std::vector<T>& pRow)
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return SetRow<T>(static_cast<size_t>(rowIdx), pRow);
+    }
+
+    /**
+     * @brief   Set row by name, moving the cells of a string row into the document.
+     * @param   pRowName              row label name.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void SetRow(const std::string& pRowName, std::vector<T>&& pRow)
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+      return SetRow<T>(static_cast<size_t>(rowIdx), std::move(pRow));
+    }
+
+    /**
+     * @brief   Remove row by index.
+     * @param   pRowIdx               zero-based row index.
+     */
+    void RemoveRow(const size_t pRowIdx)
+    {
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      if (dataRowIdx >= GetDataRowCount())
+      {
+        const std::string errStr = "row out of range: " +
+          std::to_string(pRowIdx);
+        throw std::out_of_range(errStr);
+      }
+
+      mRowGeneration = NextGeneration();
+      InvalidateColumnCache();
+      ConvertToRowMajor();
+
+      std::string rowName;
+      const bool hasRowName =
+        HasRowNames() && (mData[dataRowIdx].size() > static_cast<size_t>(mLabelParams.mRowNameIdx));
+      if (hasRowName)
+      {
+        rowName.swap(mData[dataRowIdx][static_cast<size_t>(mLabelParams.mRowNameIdx)]);
+      }
+
+      mData.erase(mData.begin() + static_cast<std::ptrdiff_t>(dataRowIdx));
+
+      if (!HasRowNames())
+      {
+        UpdateRowNames();
+      }
+      else if (!hasRowName)
+      {
+        mRowNames.Remove(dataRowIdx);
+      }
+      else if (mRowNames.Remove(rowName, dataRowIdx))
+      {
+        ResetRowName(rowName, dataRowIdx);
+      }
+    }
+
+    /**
+     * @brief   Remove row by name.
+     * @param   pRowName              row label name.
+     */
+    void RemoveRow(const std::string& pRowName)
+    {
+      int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      RemoveRow(static_cast<size_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Insert row at specified index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector of row data (optional argument).
+     * @param   pRowName              row label name (optional argument).
+     */
+    template<typename T>
+    void InsertRow(const size_t pRowIdx, const std::vector<T>& pRow = std::vector<T>(),
+                   const std::string& pRowName = std::string())
+    {
+      InsertDataRow(pRowIdx, ToDataRow<T>(pRow.begin(), pRow.end()), pRowName);
+    }
+
+    /**
+     * @brief   Insert row at specified index, moving the cells of a string row into the document.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector of row data.
+     * @param   pRowName              row label name (optional argument).
+     */
+    template<typename T>
+    void InsertRow(const size_t pRowIdx, std::vector<T>&& pRow, const std::string& pRowName = std::string())
+    {
+      InsertDataRow(pRowIdx, ToDataRow<T>(std::make_move_iterator(pRow.begin()), std::make_move_iterator(pRow.end())),
+                    pRowName);
+    }
+
+    /**
+     * @brief   Remove rows by index, compacting the remaining rows in a single pass.
+     * @param   pRowIdxs              zero-based indices of rows to remove, in any order.
+     */
+    void RemoveRows(const std::vector<size_t>& pRowIdxs)
+    {
+      std::vector<bool> isRemoved(GetRowCount(), false);
+      for (const size_t rowIdx : pRowIdxs)
+      {
+        if (rowIdx >= isRemoved.size())
+        {
+          const std::string errStr = "row out of range: " + std::to_string(rowIdx);
+          throw std::out_of_range(errStr);
+        }
+
+        isRemoved[rowIdx] = true;
+      }
+
+      RemoveDataRows(isRemoved);
+    }
+
+    /**
+     * @brief   Remove rows matching a predicate, compacting the remaining rows in a single pass.
+     *          The predicate is evaluated for all rows before any row is removed.
+     * @param   pPredicate            function returning true for zero-based indices of rows to
+     *                                remove.
+     */
+    void RemoveRows(const std::function<bool(const size_t pRowIdx)>& pPredicate)
+    {
+      std::vector<bool> isRemoved(GetRowCount(), false);
+      for (size_t rowIdx = 0; rowIdx < isRemoved.size(); ++rowIdx)
+      {
+        isRemoved[rowIdx] = pPredicate(rowIdx);
+      }
+
+      RemoveDataRows(isRemoved);
+    }
+
+    /**
+     * @brief   Insert rows at specified index, with the same result as inserting them one by one
+     *          using InsertRow() at consecutive indices.
+     * @param   pRowIdx               zero-based row index of the first inserted row.
+     * @param   pRows                 vector of rows data.
+     * @param   pRowNames             row label names, empty names being ignored (optional argument).
+     */
+    template<typename T>
+    void InsertRows(const size_t pRowIdx, const std::vector<std::vector<T>>& pRows,
+                    const std::vector<std::string>& pRowNames = std::vector<std::string>())
+    {
+      const bool hasRowNames =
+        std::any_of(pRowNames.begin(), pRowNames.end(), [](const std::string& pRowName) { return !pRowName.empty(); });
+      if (hasRowNames && (mLabelParams.mRowNameIdx < 0))
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      std::vector<std::vector<std::string>> rows;
+      rows.reserve(pRows.size());
+      for (size_t i = 0; i < pRows.size(); ++i)
+      {
+        rows.push_back(ToDataRow<T>(pRows[i].begin(), pRows[i].end()));
+        if ((i < pRowNames.size()) && !pRowNames[i].empty())
+        {
+          const size_t rowNameIdx = static_cast<size_t>(mLabelParams.mRowNameIdx);
+          if (rowNameIdx >= rows.back().size())
+          {
+            rows.back().resize(rowNameIdx + 1);
+          }
+          rows.back()[rowNameIdx] = pRowNames[i];
+        }
+      }
+
+      mRowGeneration = NextGeneration();
+      InvalidateColumnCache();
+      ConvertToRowMajor();
+      const size_t rowIdx = GetDataRowIndex(pRowIdx);
+      while (rowIdx > GetDataRowCount())
+      {
+        std::vector<std::string> tempRow;
+        tempRow.resize(GetDataColumnCount());
+        mData.push_back(tempRow);
+      }
+
+      mData.insert(mData.begin() + static_cast<std::ptrdiff_t>(rowIdx), std::make_move_iterator(rows.begin()),
+                   std::make_move_iterator(rows.end()));
+
+      UpdateRowNames();
+    }
+
+    /**
+     * @brief   Reserve storage for rows, avoiding reallocation while rows are added. Documents
+     *          with StorageLayout::Buffer reserve storage for loading only, as they are converted
+     *          upon modification.
+     * @param   pRowCount             number of data rows (excluding label rows).
+     */
+    void ReserveRows(const size_t pRowCount)
+    {
+      ReserveDataRows(GetDataRowIndex(pRowCount));
+    }
+
+    /**
+     * @brief   Reserve storage for columns in existing rows, avoiding reallocation while columns
+     *          are added. Documents with StorageLayout::Buffer are not affected, as they are
+     *          converted upon modification.
+     * @param   pColumnCount          number of data columns (excluding label columns).
+     */
+    void ReserveColumns(const size_t pColumnCount)
+    {
+      if (mLayout == StorageLayout::ColumnMajor)
+      {
+        mColumnStore.ReserveColumns(GetDataColumnIndex(pColumnCount));
+      }
+      else if (mLayout == StorageLayout::RowMajor)
+      {
+        for (std::vector<std::string>& row : mData)
+        {
+          row.reserve(GetDataColumnIndex(pColumnCount));
+        }
+      }
+    }
+
+    /**
+     * @brief   Get statistics of the memory allocated for cells, including label cells. Cells of
+     *          StorageLayout::Buffer documents are stored in slabs, released with one deallocation
+     *          per slab, while cells of other layouts may have memory allocated per cell. The
+     *          latter are counted by examining every cell.
+     * @returns storage statistics.
+     */
+    StorageStats GetStorageStats() const
+    {
+      StorageStats storageStats;
+      if (mLayout == StorageLayout::Buffer)
+      {
+        storageStats.mSlabCount = mCellBuffer.GetSlabCount();
+        storageStats.mSlabBytes = mCellBuffer.GetSlabBytes();
+        storageStats.mSlabUsedBytes = mCellBuffer.GetCellBytes();
+      }
+      else if (mLayout == StorageLayout::ColumnMajor)
+      {
+        storageStats.mCellAllocations = mColumnStore.GetCellAllocationCount();
+      }
+      else
+      {
+        const size_t inlineCapacity = std::string().capacity();
+        for (const std::vector<std::string>& row : mData)
+        {
+          for (const std::string& cell : row)
+          {
+            if (cell.capacity() > inlineCapacity)
+            {
+              ++storageStats.mCellAllocations;
+            }
+          }
+        }
+      }
+
+      return storageStats;
+    }
+
+    /**
+     * @brief   Get number of data rows (excluding label rows).
+     * @returns row count.
+     */
+    size_t GetRowCount() const
+    {
+      const std::ptrdiff_t count = static_cast<std::ptrdiff_t>(GetDataRowCount()) -
+        (mLabelParams.mColumnNameIdx + 1);
+      return (count >= 0) ? static_cast<size_t>(count) : 0;
+    }
+
+    /**
+     * @brief   Get cell by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const size_t pRowIdx) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+
+      T val;
+      Converter<T> converter(mConverterParams);
+      std::string cell;
+      converter.ToVal(GetDataCell(dataRowIdx, dataColumnIdx, cell), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+
+      T val;
+      std::string cell;
+      pToVal(GetDataCell(dataRowIdx, dataColumnIdx, cell), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const std::string& pRowName) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Get cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx), pToVal);
+    }
+
+    /**
+     * @brief   Get cell by column name and row index.
+     * @param   pColumnName           column label name.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const size_t pRowIdx) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      return GetCell<T>(static_cast<size_t>(columnIdx), pRowIdx);
+    }
+
+    /**
+     * @brief   Get cell by column name and row index.
+     * @param   pColumnName           column label name.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const size_t pRowIdx, ConvFunc<T> pToVal) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      return GetCell<T>(static_cast<size_t>(columnIdx), pRowIdx, pToVal);
+    }
+
+    /**
+     * @brief   Get cell by column index and row name.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowName              row label name.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const std::string& pRowName) const
+    {
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Get cell by column index and row name.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowName              row label name.
+     * @param   pToVal                conversion function.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const std::string& pRowName, ConvFunc<T> pToVal) const
+    {
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx), pToVal);
+    }
+
+    /**
+     * @brief   Set cell by index.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const size_t pColumnIdx, const size_t pRowIdx, const T& pCell)
+    {
+      SetDataCell(GetDataColumnIndex(pColumnIdx), GetDataRowIndex(pRowIdx), pCell);
+    }
+
+    /**
+     * @brief   Set cell by name.
+     * @param   pColumnName           column label name.
+     * @param   pRowName              row label name.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const std::string& pColumnName, const std::string& pRowName, const T& pCell)
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      SetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx), pCell);
+    }
+
+    /**
+     * @brief   Set cell by column index and row name.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowName              row label name.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const size_t pColumnIdx, const std::string& pRowName, const T& pCell)
+    {
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      SetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx), pCell);
+    }
+
+    /**
+     * @brief   Set cell by column name and row index.
+     * @param   pColumnName           column label name.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const std::string& pColumnName, const size_t pRowIdx, const T& pCell)
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      SetCell<T>(static_cast<size_t>(columnIdx), pRowIdx, pCell);
+    }
+
+    /**
+     * @brief   Get column reference by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @returns column reference.
+     */
+    ColumnRef GetColumnRef(const size_t pColumnIdx) const
+    {
+      return ColumnRef(this, GetDataColumnIndex(pColumnIdx), mColumnGeneration);
+    }
+
+    /**
+     * @brief   Get column reference by name, resolving the name once for repeated cell access.
+     * @param   pColumnName           column label name.
+     * @returns column reference.
+     */
+    ColumnRef GetColumnRef(const std::string& pColumnName) const
+    {
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
+      {
+        throw std::out_of_range("column not found: " + pColumnName);
+      }
+
+      return GetColumnRef(static_cast<size_t>(columnIdx));
+    }
+
+    /**
+     * @brief   Get row reference by index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns row reference.
+     */
+    RowRef GetRowRef(const size_t pRowIdx) const
+    {
+      return RowRef(this, GetDataRowIndex(pRowIdx), mRowGeneration);
+    }
+
+    /**
+     * @brief   Get row reference by name, resolving the name once for repeated cell access.
+     * @param   pRowName              row label name.
+     * @returns row reference.
+     */
+    RowRef GetRowRef(const std::string& pRowName) const
+    {
+      const int rowIdx = GetRowIdx(pRowName);
+      if (rowIdx < 0)
+      {
+        throw std::out_of_range("row not found: " + pRowName);
+      }
+
+      return GetRowRef(static_cast<size_t>(rowIdx));
+    }
+
+    /**
+     * @brief   Check whether a column reference is valid, i.e. it was obtained from this Document
+     *          and no columns have been inserted or removed since.
+     * @param   pColumnRef            column reference.
+     * @returns true if the reference is valid.
+     */
+    bool IsValid(const ColumnRef& pColumnRef) const
+    {
+      return (pColumnRef.mDocument == this) && (pColumnRef.mGeneration == mColumnGeneration);
+    }
+
+    /**
+     * @brief   Check whether a row reference is valid, i.e. it was obtained from this Document
+     *          and no rows have been inserted or removed since.
+     * @param   pRowRef               row reference.
+     * @returns true if the reference is valid.
+     */
+    bool IsValid(const RowRef& pRowRef) const
+    {
+      return (pRowRef.mDocument == this) && (pRowRef.mGeneration == mRowGeneration);
+    }
+
+    /**
+     * @brief   Get cell by column reference and row index.
+     * @param   pColumnRef            column reference.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const ColumnRef& pColumnRef, const size_t pRowIdx) const
+    {
+      CheckRef(pColumnRef);
+
+      T val;
+      Converter<T> converter(mConverterParams);
+      std::string cell;
+      converter.ToVal(GetDataCell(GetDataRowIndex(pRowIdx), pColumnRef.mDataColumnIdx, cell), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell by column and row reference.
+     * @param   pColumnRef            column reference.
+     * @param   pRowRef               row reference.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCell(const ColumnRef& pColumnRef, const RowRef& pRowRef) const
+    {
+      CheckRef(pColumnRef);
+      CheckRef(pRowRef);
+
+      T val;
+      Converter<T> converter(mConverterParams);
+      std::string cell;
+      converter.ToVal(GetDataCell(pRowRef.mDataRowIdx, pColumnRef.mDataColumnIdx, cell), val);
+      return val;
+    }
+
+    /**
+     * @brief   Get cell by column reference and row index, without checking the validity of the
+     *          reference or the bounds of the cell, other than by assertions in debug builds.
+     *          Passing a reference obtained from another Document, or an invalidated one, is
+     *          undefined behavior in release builds. Only the RowMajor layout reads the cell
+     *          directly, the Buffer and ColumnMajor layouts still locate it per layout.
+     * @param   pColumnRef            valid column reference.
+     * @param   pRowIdx               zero-based row index of an existing cell.
+     * @returns cell data.
+     */
+    template<typename T>
+    T GetCellUnchecked(const ColumnRef& pColumnRef, const size_t pRowIdx) const
+    {
+      assert(IsValid(pColumnRef));
+
+      T val;
+      Converter<T> converter(mConverterParams);
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      if (mLayout == StorageLayout::RowMajor)
+      {
+        assert((dataRowIdx < mData.size()) && (pColumnRef.mDataColumnIdx < mData[dataRowIdx].size()));
+        converter.ToVal(mData[dataRowIdx][pColumnRef.mDataColumnIdx], val);
+      }
+      else
+      {
+        std::string cell;
+        converter.ToVal(GetDataCell(dataRowIdx, pColumnRef.mDataColumnIdx, cell), val);
+      }
+      return val;
+    }
+
+    /**
+     * @brief   Set cell by column reference and row index.
+     * @param   pColumnRef            column reference.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const ColumnRef& pColumnRef, const size_t pRowIdx, const T& pCell)
+    {
+      CheckRef(pColumnRef);
+      SetDataCell(pColumnRef.mDataColumnIdx, GetDataRowIndex(pRowIdx), pCell);
+    }
+
+    /**
+     * @brief   Set cell by column and row reference.
+     * @param   pColumnRef            column reference.
+     * @param   pRowRef               row reference.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void SetCell(const ColumnRef& pColumnRef, const RowRef& pRowRef, const T& pCell)
+    {
+      CheckRef(pColumnRef);
+      CheckRef(pRowRef);
+      SetDataCell(pColumnRef.mDataColumnIdx, pRowRef.mDataRowIdx, pCell);
+    }
+
+    /**
+     * @brief   Get column name
+     * @param   pColumnIdx            zero-based column index.
+     * @returns column name.
+     */
+    std::string GetColumnName(const size_t pColumnIdx) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      if (mLabelParams.mColumnNameIdx < 0)
+      {
+        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+      }
+
+      std::string cell;
+      return GetDataCell(static_cast<size_t>(mLabelParams.mColumnNameIdx), dataColumnIdx, cell);
+    }
+
+    /**
+     * @brief   Set column name
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pColumnName           column name.
+     */
+    void SetColumnName(size_t pColumnIdx, const std::string& pColumnName)
+    {
+      ConvertToColumnModifiable();
+      if (mLabelParams.mColumnNameIdx < 0)
+      {
+        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+      }
+
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+
+      // remove old name from map before adding new one
+      const size_t nameRowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
+      if ((nameRowIdx < GetDataRowCount()) && (dataColumnIdx < GetDataRowSize(nameRowIdx)))
+      {
+        const std::string oldName = GetDataCell(nameRowIdx, dataColumnIdx);
+        if (mColumnNames.Erase(oldName, dataColumnIdx))
+        {
+          ResetColumnName(oldName, dataColumnIdx);
+        }
+      }
+      mColumnNames.Add(pColumnName, dataColumnIdx);
+
+      // increase table size if necessary:
+      const size_t rowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
+      while (rowIdx >= GetDataRowCount())
+      {
+        AppendDataRow(std::vector<std::string>());
+      }
+
+      if (dataColumnIdx >= GetDataRowSize(rowIdx))
+      {
+        ResizeDataRow(rowIdx, dataColumnIdx + 1);
+      }
+
+      GetDataCell(rowIdx, dataColumnIdx) = pColumnName;
+    }
+
+    /**
+     * @brief   Get column names
+     * @returns vector of column names.
+     */
+    std::vector<std::string> GetColumnNames() const
+    {
+      std::vector<std::string> columnNames;
+      if (mLabelParams.mColumnNameIdx >= 0)
+      {
+        const size_t labelRowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
+        const size_t labelRowSize = GetDataRowSize(labelRowIdx);
+        std::string cell;
+        for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < labelRowSize; ++dataColumnIdx)
+        {
+          columnNames.push_back(GetDataCell(labelRowIdx, dataColumnIdx, cell));
+        }
+      }
+
+      return columnNames;
+    }
+
+    /**
+     * @brief   Get row name
+     * @param   pRowIdx               zero-based column index.
+     * @returns row name.
+     */
+    std::string GetRowName(const size_t pRowIdx) const
+    {
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      if (mLabelParams.mRowNameIdx < 0)
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      std::string cell;
+      return GetDataCell(dataRowIdx, static_cast<size_t>(mLabelParams.mRowNameIdx), cell);
+    }
+
+    /**
+     * @brief   Set row name
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRowName              row name.
+     */
+    void SetRowName(size_t pRowIdx, const std::string& pRowName)
+    {
+      ConvertToRowMajor();
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      if (mLabelParams.mRowNameIdx >= 0)
+      {
+        InvalidateColumnCache(static_cast<size_t>(mLabelParams.mRowNameIdx), dataRowIdx >= mData.size());
+      }
+
+      // remove old name from map before adding new one
+      if ((mLabelParams.mRowNameIdx >= 0) && (dataRowIdx < mData.size()) &&
+          (static_cast<size_t>(mLabelParams.mRowNameIdx) < mData.at(dataRowIdx).size()))
+      {
+        const std::string oldName = mData.at(dataRowIdx).at(static_cast<size_t>(mLabelParams.mRowNameIdx));
+        if (mRowNames.Erase(oldName, dataRowIdx))
+        {
+          ResetRowName(oldName, dataRowIdx);
+        }
+      }
+      mRowNames.Add(pRowName, dataRowIdx);
+      if (mLabelParams.mRowNameIdx < 0)
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      // increase table size if necessary:
+      if (dataRowIdx >= mData.size())
+      {
+        mData.resize(dataRowIdx + 1);
+      }
+
+      std::vector<std::string>& row = mData[dataRowIdx];
+      if (mLabelParams.mRowNameIdx >= static_cast<std::ptrdiff_t>(row.size()))
+      {
+        row.resize(static_cast<size_t>(mLabelParams.mRowNameIdx) + 1);
+      }
+
+      mData.at(dataRowIdx).at(static_cast<size_t>(mLabelParams.mRowNameIdx)) = pRowName;
+    }
+
+    /**
+     * @brief   Get row names
+     * @returns vector of row names.
+     */
+    std::vector<std::string> GetRowNames() const
+    {
+      std::vector<std::string> rownames;
+      if (mLabelParams.mRowNameIdx >= 0)
+      {
+        std::string cell;
+        for (size_t dataRowIdx = GetDataRowIndex(0); dataRowIdx < GetDataRowCount(); ++dataRowIdx)
+        {
+          rownames.push_back(GetDataCell(dataRowIdx, static_cast<size_t>(mLabelParams.mRowNameIdx), cell));
+        }
+      }
+      return rownames;
+    }
+
+  private:
+    void ReadCsv()
+    {
+#if defined(RAPIDCSV_HAS_MMAP)
+      if (mLoadParams.mMemoryMap)
+      {
+        const MappedFile file(mPath);
+        ReadCsv(file.GetData(), file.GetSize());
+        return;
+      }
+#endif
+
+      std::ifstream stream;
+      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      stream.open(mPath, std::ios::binary);
+      ReadCsv(stream);
+    }
+
+    void ReadCsv(std::istream& pStream)
+    {
+      Clear();
+      InitLoad();
+      pStream.seekg(0, std::ios::end);
+      std::streamsize length = pStream.tellg();
+      pStream.seekg(0, std::ios::beg);
+
+      std::vector<char> bom2b(2, '\0');
+      if (length >= 2)
+      {
+        pStream.read(bom2b.data(), 2);
+        pStream.seekg(0, std::ios::beg);
+      }
+
+      if (IsUtf16BOM(bom2b.data(), bom2b.size()))
+      {
+        mIsUtf16 = true;
+        mIsLE = (bom2b[0] == '\xff');
+
+        std::vector<char> buffer(static_cast<size_t>(length));
+        pStream.read(buffer.data(), length);
+
+        // skip byte order mark
+        const std::string utf8 = Utf16ToUtf8(buffer.data() + 2, static_cast<size_t>(length) - 2,
+                                             mIsLE);
+        ParseCsv(utf8.data(), utf8.size());
+      }
+      else
+      {
+        // check for UTF-8 Byte order mark and skip it when found
+        if (length >= 3)
+        {
+          std::vector<char> bom3b(3, '\0');
+          pStream.read(bom3b.data(), 3);
+
+          if (bom3b != s_Utf8BOM)
+          {
+            // file does not start with a UTF-8 Byte order mark
+            pStream.seekg(0, std::ios::beg);
+          }
+          else
+          {
+            // file did start with a UTF-8 Byte order mark, simply skip it
+            length -= 3;
+            mHasUtf8BOM = true;
+          }
+        }
+
+        ParseCsv(pStream, length);
+      }
+    }
+
+    void ReadCsv(const char* pData, size_t pLength)
+    {
+      Clear();
+      InitLoad();
+      if (IsUtf16BOM(pData, pLength))
+      {
+        mIsUtf16 = true;
+        mIsLE = (pData[0] == '\xff');
+
+        // skip byte order mark
+        const std::string utf8 = Utf16ToUtf8(pData + 2, pLength - 2, mIsLE);
+        ParseCsv(utf8.data(), utf8.size());
+      }
+      else
+      {
+        // check for UTF-8 Byte order mark and skip it when found
+        if ((pLength >= 3) && std::equal(s_Utf8BOM.begin(), s_Utf8BOM.end(), pData))
+        {
+          pData += 3;
+          pLength -= 3;
+          mHasUtf8BOM = true;
+        }
+
+        ParseCsv(pData, pLength);
+      }
+    }
+
+    static bool IsUtf16BOM(const char* pData, size_t pLength)
+    {
+      return (pLength >= 2) &&
+             (((pData[0] == '\xff') && (pData[1] == '\xfe')) ||
+              ((pData[0] == '\xfe') && (pData[1] == '\xff')));
+    }
+
+    // Returns a generation unique within the process, so that a reference outliving its Document
+    // is not accepted by another Document constructed at the same address.
+    static size_t NextGeneration()
+    {
+      static std::atomic<size_t> s_Generation(0);
+      return ++s_Generation;
+    }
+
+    static inline void CheckMaxCount(const size_t pCount)
+    {
+#ifdef RAPIDCSV_MAX_COUNT
+      static_assert(RAPIDCSV_MAX_COUNT > 0, "RAPIDCSV_MAX_COUNT must be a positive value");
+      static const size_t s_MaxCount = static_cast<size_t>(RAPIDCSV_MAX_COUNT);
+      if (pCount > s_MaxCount)
+      {
+        const std::string errStr = "max count exceeded: " + std::to_string(s_MaxCount);
+        throw std::out_of_range(errStr);
+      }
+#else
+      (void)pCount;
+#endif
+    }
+
+    // Returns a pointer to the first separator, quote or linebreak character in the range
+    // [pBegin, pEnd), or pEnd if there is none. The lookup table pIsSpecial must flag the
+    // same characters as the ones compared against in the vectorized code path.
+    const char* FindSpecialChar(const char* pBegin, const char* pEnd, const bool* pIsSpecial) const
+    {
+      const char* pos = pBegin;
+#if defined(RAPIDCSV_AVX2)
+      const __m256i quoteChar = _mm256_set1_epi8(mSeparatorParams.mQuoteChar);
+      const __m256i separator = _mm256_set1_epi8(mSeparatorParams.mSeparator);
+      const __m256i cr = _mm256_set1_epi8('\r');
+      const __m256i lf = _mm256_set1_epi8('\n');
+      while ((pEnd - pos) >= 32)
+      {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos));
+        const __m256i match =
+          _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quoteChar), _mm256_cmpeq_epi8(chunk, separator)),
+                          _mm256_or_si256(_mm256_cmpeq_epi8(chunk, cr), _mm256_cmpeq_epi8(chunk, lf)));
+        const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(match));
+        if (mask != 0)
+        {
+          return pos + CountTrailingZeros(mask);
+        }
+        pos += 32;
+      }
+#elif defined(RAPIDCSV_SSE2)
+      const __m128i quoteChar = _mm_set1_epi8(mSeparatorParams.mQuoteChar);
+      const __m128i separator = _mm_set1_epi8(mSeparatorParams.mSeparator);
+      const __m128i cr = _mm_set1_epi8('\r');
+      const __m128i lf = _mm_set1_epi8('\n');
+      while ((pEnd - pos) >= 16)
+      {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pos));
+        const __m128i match =
+          _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quoteChar), _mm_cmpeq_epi8(chunk, separator)),
+                       _mm_or_si128(_mm_cmpeq_epi8(chunk, cr), _mm_cmpeq_epi8(chunk, lf)));
+        const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(match));
+        if (mask != 0)
+        {
+          return pos + CountTrailingZeros(mask);
+        }
+        pos += 16;
+      }
+#endif
+
+      while ((pos < pEnd) && !pIsSpecial[static_cast<unsigned char>(*pos)])
+      {
+        ++pos;
+      }
+      return pos;
+    }
+
+#if defined(RAPIDCSV_AVX2) || defined(RAPIDCSV_SSE2)
+    static inline unsigned int CountTrailingZeros(const unsigned int pMask)
+    {
+#if defined(_MSC_VER)
+      unsigned long idx = 0;
+      _BitScanForward(&idx, pMask);
+      return static_cast<unsigned int>(idx);
+#else
+      return static_cast<unsigned int>(__builtin_ctz(pMask));
+#endif
+    }
+#endif
+
+    // Holds the parser state carried over between consecutive buffers of input data. When
+    // mDeferRows is set, parsed rows are collected in mRows instead of being added to the
+    // Document, which allows chunks of data to be parsed concurrently, and rows to be streamed
+    // by a Reader.
+    struct ParseState
+    {
+      explicit ParseState(const SeparatorParams& pSeparatorParams,
+                          const std::vector<bool>& pFieldMask = std::vector<bool>())
+        : mIsSpecial()
+        , mRow()
+        , mCell()
+        , mQuoted(false)
+        , mCr(0)
+        , mLf(0)
+        , mDeferRows(false)
+        , mRows()
+        , mFieldMask(pFieldMask)
+        , mFieldIdx(0)
+        , mCommentLine(false)
+        , mRecordRowEnds(false)
+        , mRowEnds()
+      {
+        mIsSpecial[static_cast<unsigned char>(pSeparatorParams.mQuoteChar)] = true;
+        mIsSpecial[static_cast<unsigned char>(pSeparatorParams.mSeparator)] = true;
+        mIsSpecial[static_cast<unsigned char>('\r')] = true;
+        mIsSpecial[static_cast<unsigned char>('\n')] = true;
+      }
+
+      bool mIsSpecial[256];
+      std::vector<std::string> mRow;
+      std::string mCell;
+      bool mQuoted;
+      int mCr;
+      int mLf;
+      bool mDeferRows;
+      std::vector<std::vector<std::string>> mRows;
+
+      // fields of each line to be kept as cells, or empty to keep all fields
+      std::vector<bool> mFieldMask;
+      size_t mFieldIdx;
+      bool mCommentLine;
+
+      // when set, the end of each row taken at a linebreak is recorded, for indexing rows
+      bool mRecordRowEnds;
+      std::vector<const char*> mRowEnds;
+    };
+
+    void ParseCsv(std::istream& pStream, std::streamsize p_FileLength)
+    {
+      if (GetParseThreadCount() > 1)
+      {
+        // concurrent parsing requires all data to be available up front
+        std::vector<char> data(static_cast<size_t>(std::max<std::streamsize>(p_FileLength, 0)));
+        pStream.read(data.data(), static_cast<std::streamsize>(data.size()));
+        ParseCsv(data.data(), static_cast<size_t>(std::max<std::streamsize>(pStream.gcount(), 0)));
+        return;
+      }
+
+      const std::streamsize bufLength = 64 * 1024;
+      std::vector<char> buffer(bufLength);
+      ParseState state(mSeparatorParams, mProjectedFields);
+      const size_t length = static_cast<size_t>(std::max<std::streamsize>(p_FileLength, 0));
+
+      while ((p_FileLength > 0) && !mLoadDone)
+      {
+        const std::streamsize toReadLength = std::min<std::streamsize>(p_FileLength, bufLength);
+        pStream.read(buffer.data(), toReadLength);
+
+        // With user-specified istream opened in non-binary mode on windows, we may have a
+        // data length mismatch, so ensure we don't parse outside actual data length read.
+        const std::streamsize readLength = pStream.gcount();
+        if (readLength <= 0)
+        {
+          break;
+        }
+
+        if (static_cast<size_t>(p_FileLength) == length)
+        {
+          ReserveParsedData(buffer.data(), static_cast<size_t>(readLength), length);
+        }
+
+        ParseBuffer(buffer.data(), buffer.data() + readLength, state);
+        p_FileLength -= readLength;
+      }
+
+      ParseEnd(state);
+    }
+
+    void ParseCsv(const char* pData, size_t pLength)
+    {
+      ReserveParsedData(pData, pLength, pLength);
+      if (GetParseThreadCount() > 1)
+      {
+        ParseCsvConcurrently(pData, pLength);
+        return;
+      }
+
+      ParseState state(mSeparatorParams, mProjectedFields);
+      ParseBuffer(pData, pData + pLength, state);
+      ParseEnd(state);
+    }
+
+    size_t GetParseThreadCount() const
+    {
+      if (mLoadParams.mThreadCount == 0)
+      {
+        return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+      }
+
+      return mLoadParams.mThreadCount;
+    }
+
+    // Parses the data as chunks starting after the first linebreak following evenly spaced
+    // offsets. Each chunk is parsed speculatively assuming it starts on a new row. That holds
+    // unless the linebreak is part of a quoted cell, which is detected when the preceding
+    // chunk ends in the middle of a row. The preceding chunk then continues parsing the data
+    // of the chunk, whose result is discarded. Hence the result is identical to serial parsing.
+    void ParseCsvConcurrently(const char* pData, const size_t pLength)
+    {
+      const size_t minChunkLength = 256 * 1024;
+      const size_t threadCount = std::min(GetParseThreadCount(), std::max<size_t>(pLength / minChunkLength, 1));
+      const char* end = pData + pLength;
+      std::vector<const char*> chunks(1, pData);
+      for (size_t i = 1; i < threadCount; ++i)
+      {
+        const char* split = std::max(pData + ((pLength / threadCount) * i), chunks.back());
+        const char* lf = static_cast<const char*>(memchr(split, '\n', static_cast<size_t>(end - split)));
+        if ((lf == nullptr) || ((lf + 1) == end))
+        {
+          break;
+        }
+
+        chunks.push_back(lf + 1);
+      }
+      chunks.push_back(end);
+
+      const size_t chunkCount = chunks.size() - 1;
+      std::vector<ParseState> states(chunkCount, ParseState(mSeparatorParams, mProjectedFields));
+      std::vector<std::exception_ptr> errors(chunkCount);
+      auto parseChunk = [&](const size_t pChunkIdx)
+      {
+        try
+        {
+          states[pChunkIdx].mDeferRows = true;
+          ParseBuffer(chunks[pChunkIdx], chunks[pChunkIdx + 1], states[pChunkIdx]);
+        }
+        catch (...)
+        {
+          errors[pChunkIdx] = std::current_exception();
+        }
+      };
+
+      std::vector<std::thread> threads;
+      try
+      {
+        for (size_t chunkIdx = 1; chunkIdx < chunkCount; ++chunkIdx)
+        {
+          threads.emplace_back(parseChunk, chunkIdx);
+        }
+      }
+      catch (...)
+      {
+        for (std::thread& thread : threads)
+        {
+          thread.join();
+        }
+        throw;
+      }
+
+      parseChunk(0);
+      for (std::thread& thread : threads)
+      {
+        thread.join();
+      }
+
+      // stitch the rows of the chunks together in order
+      size_t stateIdx = 0;
+      for (size_t chunkIdx = 1; chunkIdx <= chunkCount; ++chunkIdx)
+      {
+        if (errors[stateIdx])
+        {
+          std::rethrow_exception(errors[stateIdx]);
+        }
+
+        ParseState& state = states[stateIdx];
+        if ((chunkIdx < chunkCount) && ((state.mFieldIdx > 0) || !state.mCell.empty()))
+        {
+          // chunk starts within a row, continue parsing it from the preceding chunk
+          ParseBuffer(chunks[chunkIdx], chunks[chunkIdx + 1], state);
+          continue;
+        }
+
+        for (std::vector<std::string>& row : state.mRows)
+        {
+          if (mLoadDone)
+          {
+            break;
+          }
+          AddParsedRow(std::move(row), !state.mFieldMask.empty());
+        }
+        std::vector<std::vector<std::string>>().swap(state.mRows);
+
+        if (chunkIdx < chunkCount)
+        {
+          states[chunkIdx].mCr += state.mCr;
+          states[chunkIdx].mLf += state.mLf;
+          stateIdx = chunkIdx;
+        }
+      }
+
+      ParseState& lastState = states[stateIdx];
+      lastState.mDeferRows = false;
+      ParseEnd(lastState);
+    }
+
+    void ParseBuffer(const char* pBegin, const char* pEnd, ParseState& pState)
+    {
+      std::vector<std::string>& row = pState.mRow;
+      std::string& cell = pState.mCell;
+      bool& quoted = pState.mQuoted;
+      int& cr = pState.mCr;
+      int& lf = pState.mLf;
+
+      const char* pos = pBegin;
+      while (pos < pEnd)
+      {
+        // bulk copy the run of regular characters preceding the next special character
+        const char* special = FindSpecialChar(pos, pEnd, pState.mIsSpecial);
+        cell.append(pos, special);
+        if (special == pEnd)
+        {
+          break;
+        }
+
+        pos = special;
+        if (*pos == mSeparatorParams.mQuoteChar)
+        {
+          if (cell.empty() || (cell[0] == mSeparatorParams.mQuoteChar))
+          {
+            quoted = !quoted;
+          }
+          else if (mSeparatorParams.mTrim)
+          {
+            // allow whitespace before first mQuoteChar
+            const auto firstQuote = std::find(cell.begin(), cell.end(), mSeparatorParams.mQuoteChar);
+            if (std::all_of(cell.begin(), firstQuote, [](unsigned char ch) { return isspace(ch); }))
+            {
+              quoted = !quoted;
+            }
+          }
+          cell += *pos;
+        }
+        else if (*pos == mSeparatorParams.mSeparator)
+        {
+          if (!quoted)
+          {
+            TakeParsedCell(pState);
+            cell.clear();
+          }
+          else
+          {
+            cell += *pos;
+          }
+        }
+        else if (*pos == '\r')
+        {
+          if (mSeparatorParams.mQuotedLinebreaks && quoted)
+          {
+            cell += *pos;
+          }
+          else
+          {
+            ++cr;
+          }
+        }
+        else if (*pos == '\n')
+        {
+          if (mSeparatorParams.mQuotedLinebreaks && quoted)
+          {
+            cell += *pos;
+          }
+          else
+          {
+            ++lf;
+            if (mLineReaderParams.mSkipEmptyLines && (pState.mFieldIdx == 0) && cell.empty())
+            {
+              // skip empty line
+            }
+            else
+            {
+              TakeParsedCell(pState);
+
+              if (pState.mCommentLine)
+              {
+                // skip comment line
+              }
+              else
+              {
+                TakeParsedRow(pState);
+                if (pState.mRecordRowEnds)
+                {
+                  pState.mRowEnds.push_back(pos + 1);
+                }
+              }
+
+              cell.clear();
+              row.clear();
+              quoted = false;
+              pState.mFieldIdx = 0;
+              pState.mCommentLine = false;
+              if (mLoadDone)
+              {
+                return;
+              }
+            }
+          }
+        }
+
+        ++pos;
+      }
+    }
+
+    void ParseEnd(ParseState& pState)
+    {
+      ParseLastRow(pState);
+      if (mProjectionPending)
+      {
+        // data ended before the column label row
+        ResolveProjection();
+      }
+
+      // release storage reserved for an overestimated number of rows
+      if ((mLoadParams.mRowCountHint == 0) && (mData.capacity() > (2 * mData.size())))
+      {
+        mData.shrink_to_fit();
+      }
+
+      // Assume CR/LF if at least half the linebreaks have CR
+      mSeparatorParams.mHasCR = (pState.mCr > (pState.mLf / 2));
+
+      // Set up column labels
+      UpdateColumnNames();
+
+      // Set up row labels
+      UpdateRowNames();
+
+      EncodeDictionaryColumns();
+    }
+
+    void CheckColumnDictionaryEncoded(const size_t pColumnIdx) const
+    {
+      if (!IsColumnDictionaryEncoded(pColumnIdx))
+      {
+        throw std::out_of_range("column not dictionary encoded: " + std::to_string(pColumnIdx));
+      }
+    }
+
+    void EncodeDictionaryColumns()
+    {
+      if (mLayout != StorageLayout::ColumnMajor)
+      {
+        return;
+      }
+
+      const size_t firstDataRowIdx = GetDataRowIndex(0);
+      for (const std::string& columnName : mStorageParams.mDictionaryColumns)
+      {
+        const int columnIdx = GetColumnIdx(columnName);
+        if (columnIdx < 0)
+        {
+          throw std::out_of_range("column not found: " + columnName);
+        }
+        mColumnStore.Encode(GetDataColumnIndex(static_cast<size_t>(columnIdx)), firstDataRowIdx,
+                            std::numeric_limits<uint32_t>::max());
+      }
+
+      if ((mStorageParams.mDictionaryMaxSize == 0) || (GetDataRowCount() <= firstDataRowIdx))
+      {
+        return;
+      }
+
+      // sample the first cells of each column to select low-cardinality columns
+      const size_t sampleEndIdx = std::min(GetDataRowCount(), firstDataRowIdx + 1024);
+      std::string cell;
+      for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < GetDataColumnCount(); ++dataColumnIdx)
+      {
+        LabelIndex sample;
+        size_t sampleCount = 0;
+        for (size_t dataRowIdx = firstDataRowIdx; dataRowIdx < sampleEndIdx; ++dataRowIdx)
+        {
+          if (dataColumnIdx < GetDataRowSize(dataRowIdx))
+          {
+            const std::string& sampleCell = GetDataCell(dataRowIdx, dataColumnIdx, cell);
+            size_t idx = 0;
+            if (!sample.Find(sampleCell.data(), sampleCell.size(), idx))
+            {
+              sample.Set(sampleCell, sampleCount++);
+            }
+          }
+        }
+
+        if ((sampleCount * 4) <= (sampleEndIdx - firstDataRowIdx))
+        {
+          mColumnStore.Encode(dataColumnIdx, firstDataRowIdx,
+                              std::min<size_t>(mStorageParams.mDictionaryMaxSize, std::numeric_limits<uint32_t>::max()));
+        }
+      }
+    }
+
+    void ParseLastRow(ParseState& pState)
+    {
+      std::vector<std::string>& row = pState.mRow;
+      std::string& cell = pState.mCell;
+      bool& quoted = pState.mQuoted;
+
+      // Handle last row / cell without linebreak
+      if ((pState.mFieldIdx == 0) && cell.empty())
+      {
+        // skip empty trailing line
+      }
+      else
+      {
+        TakeParsedCell(pState);
+
+        if (pState.mCommentLine)
+        {
+          // skip comment line
+        }
+        else
+        {
+          TakeParsedRow(pState);
+        }
+
+        cell.clear();
+        row.clear();
+        quoted = false;
+        pState.mFieldIdx = 0;
+        pState.mCommentLine = false;
+      }
+    }
+
+    void WriteCsv() const
+    {
+      std::ofstream stream;
+      stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+      stream.open(mPath, std::ios::binary | std::ios::trunc);
+      WriteBOM(stream, mIsUtf16, mIsLE, mHasUtf8BOM);
+      WriteCsv(stream, mIsUtf16);
+    }
+
+    void WriteCsv(std::ostream& pStream, const bool pIsUtf16 = false) const
+    {
+      // rows are formatted into a buffer, which is transcoded and written once full
+      static const size_t s_WriteBufferSize = 1024 * 1024;
+      const QuoteTable quoteTable(mSeparatorParams);
+      const std::string rowEnd = mSeparatorParams.mHasCR ? "\r\n" : "\n";
+      std::string buffer;
+      std::string utf16;
+      std::string cell;
+
+      // reserved beyond the flush threshold, so that the buffer is rarely reallocated
+      buffer.reserve(2 * s_WriteBufferSize);
+      for (size_t dataRowIdx = 0; dataRowIdx < GetDataRowCount(); ++dataRowIdx)
+      {
+        const size_t rowSize = GetDataRowSize(dataRowIdx);
+        for (size_t dataColumnIdx = 0; dataColumnIdx < rowSize; ++dataColumnIdx)
+        {
+          if (dataColumnIdx > 0)
+          {
+            buffer += mSeparatorParams.mSeparator;
+          }
+
+          AppendCell(GetDataCell(dataRowIdx, dataColumnIdx, cell), mSeparatorParams, quoteTable, buffer);
+        }
+        buffer += rowEnd;
+
+        if (buffer.size() >= s_WriteBufferSize)
+        {
+          WriteBuffer(pStream, pIsUtf16, mIsLE, buffer, utf16);
+        }
+      }
+
+      WriteBuffer(pStream, pIsUtf16, mIsLE, buffer, utf16);
+    }
+
+    // The snapshot holds a header of native endian 64-bit values, the Document path padded to
+    // a multiple of 8 bytes, the index of the first cell of each row and the end offset of each
+    // cell, followed by the cell data. The offset arrays are thus aligned when memory mapped.
+    void WriteSnapshot(std::ostream& pStream) const
+    {
+      std::vector<uint64_t> rowOffsets(1, 0);
+      std::vector<uint64_t> cellOffsets(1, 0);
+      rowOffsets.reserve(GetDataRowCount() + 1);
+      std::string cell;
+      for (size_t dataRowIdx = 0; dataRowIdx < GetDataRowCount(); ++dataRowIdx)
+      {
+        const size_t rowSize = GetDataRowSize(dataRowIdx);
+        for (size_t dataColumnIdx = 0; dataColumnIdx < rowSize; ++dataColumnIdx)
+        {
+          cellOffsets.push_back(cellOffsets.back() + GetDataCell(dataRowIdx, dataColumnIdx, cell).size());
+        }
+        rowOffsets.push_back(cellOffsets.size() - 1);
+      }
+
+      const uint64_t flags = static_cast<uint64_t>(mIsUtf16) |
+                             (static_cast<uint64_t>(mIsLE) << 1) |
+                             (static_cast<uint64_t>(mHasUtf8BOM) << 2) |
+                             (static_cast<uint64_t>(mSeparatorParams.mTrim) << 3) |
+                             (static_cast<uint64_t>(mSeparatorParams.mHasCR) << 4) |
+                             (static_cast<uint64_t>(mSeparatorParams.mQuotedLinebreaks) << 5) |
+                             (static_cast<uint64_t>(mSeparatorParams.mAutoQuote) << 6) |
+                             (static_cast<uint64_t>(static_cast<unsigned char>(mSeparatorParams.mSeparator)) << 8) |
+                             (static_cast<uint64_t>(static_cast<unsigned char>(mSeparatorParams.mQuoteChar)) << 16);
+      const uint64_t header[] = { s_SnapshotByteOrder, flags,
+                                  static_cast<uint64_t>(static_cast<int64_t>(mLabelParams.mColumnNameIdx)),
+                                  static_cast<uint64_t>(static_cast<int64_t>(mLabelParams.mRowNameIdx)),
+                                  mPath.size(), rowOffsets.size() - 1, cellOffsets.size() - 1, cellOffsets.back() };
+      pStream.write(s_SnapshotMagic.data(), static_cast<std::streamsize>(s_SnapshotMagic.size()));
+      pStream.write(reinterpret_cast<const char*>(header), sizeof(header));
+      std::string path = mPath;
+      path.resize(GetSnapshotPadded(path.size()), '\0');
+      pStream.write(path.data(), static_cast<std::streamsize>(path.size()));
+      pStream.write(reinterpret_cast<const char*>(rowOffsets.data()),
+                    static_cast<std::streamsize>(rowOffsets.size() * sizeof(uint64_t)));
+      pStream.write(reinterpret_cast<const char*>(cellOffsets.data()),
+                    static_cast<std::streamsize>(cellOffsets.size() * sizeof(uint64_t)));
+
+      static const size_t s_WriteBufferSize = 1024 * 1024;
+      std::string buffer;
+      for (size_t dataRowIdx = 0; dataRowIdx < GetDataRowCount(); ++dataRowIdx)
+      {
+        const size_t rowSize = GetDataRowSize(dataRowIdx);
+        for (size_t dataColumnIdx = 0; dataColumnIdx < rowSize; ++dataColumnIdx)
+        {
+          buffer += GetDataCell(dataRowIdx, dataColumnIdx, cell);
+        }
+
+        if (buffer.size() >= s_WriteBufferSize)
+        {
+          pStream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+          buffer.clear();
+        }
+      }
+      pStream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+
+    void ReadSnapshot(const std::string& pPath, const char* pData, const size_t pLength)
+    {
+      // validate sizes before accessing the data they describe
+      const size_t magicSize = s_SnapshotMagic.size();
+      const size_t headerCount = 8;
+      const size_t headerEnd = magicSize + (headerCount * sizeof(uint64_t));
+      if ((pLength < headerEnd) || !std::equal(s_SnapshotMagic.begin(), s_SnapshotMagic.end(), pData))
+      {
+        throw std::invalid_argument("invalid snapshot: " + pPath);
+      }
+
+      const uint64_t* header = reinterpret_cast<const uint64_t*>(pData + magicSize);
+      if ((header[0] != s_SnapshotByteOrder) || (header[4] > pLength) ||
+          (header[5] > (pLength / sizeof(uint64_t))) || (header[6] > (pLength / sizeof(uint64_t))))
+      {
+        throw std::invalid_argument("invalid snapshot: " + pPath);
+      }
+
+      const size_t pathSize = static_cast<size_t>(header[4]);
+      const size_t rowCount = static_cast<size_t>(header[5]);
+      const size_t cellCount = static_cast<size_t>(header[6]);
+      const size_t rowOffsetsBegin = headerEnd + GetSnapshotPadded(pathSize);
+      const size_t cellOffsetsBegin = rowOffsetsBegin + ((rowCount + 1) * sizeof(uint64_t));
+      const size_t dataBegin = cellOffsetsBegin + ((cellCount + 1) * sizeof(uint64_t));
+      const uint64_t* rowOffsets = reinterpret_cast<const uint64_t*>(pData + rowOffsetsBegin);
+      const uint64_t* cellOffsets = reinterpret_cast<const uint64_t*>(pData + cellOffsetsBegin);
+      if ((dataBegin > pLength) || (header[7] != (pLength - dataBegin)) ||
+          (rowOffsets[0] != 0) || (rowOffsets[rowCount] != cellCount) ||
+          !std::is_sorted(rowOffsets, rowOffsets + rowCount + 1) ||
+          (cellOffsets[0] != 0) || (cellOffsets[cellCount] != header[7]) ||
+          !std::is_sorted(cellOffsets, cellOffsets + cellCount + 1))
+      {
+        throw std::invalid_argument("invalid snapshot: " + pPath);
+      }
+
+      Clear();
+      const uint64_t flags = header[1];
+      mIsUtf16 = ((flags & 0x1) != 0);
+      mIsLE = ((flags & 0x2) != 0);
+      mHasUtf8BOM = ((flags & 0x4) != 0);
+      mSeparatorParams.mTrim = ((flags & 0x8) != 0);
+      mSeparatorParams.mHasCR = ((flags & 0x10) != 0);
+      mSeparatorParams.mQuotedLinebreaks = ((flags & 0x20) != 0);
+      mSeparatorParams.mAutoQuote = ((flags & 0x40) != 0);
+      mSeparatorParams.mSeparator = static_cast<char>((flags >> 8) & 0xff);
+      mSeparatorParams.mQuoteChar = static_cast<char>((flags >> 16) & 0xff);
+      mLabelParams.mColumnNameIdx = static_cast<int>(static_cast<int64_t>(header[2]));
+      mLabelParams.mRowNameIdx = static_cast<int>(static_cast<int64_t>(header[3]));
+      mPath.assign(pData + headerEnd, pathSize);
+
+      const char* data = pData + dataBegin;
+      if (mLayout == StorageLayout::Buffer)
+      {
+        mCellBuffer.Assign(data, cellOffsets, cellCount, rowOffsets, rowCount);
+      }
+      else
+      {
+        ReserveDataRows(rowCount);
+        for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+        {
+          std::vector<std::string> row(static_cast<size_t>(rowOffsets[rowIdx + 1] - rowOffsets[rowIdx]));
+          for (size_t columnIdx = 0; columnIdx < row.size(); ++columnIdx)
+          {
+            const size_t cellIdx = static_cast<size_t>(rowOffsets[rowIdx]) + columnIdx;
+            row[columnIdx].assign(data + cellOffsets[cellIdx], data + cellOffsets[cellIdx + 1]);
+          }
+          StoreParsedRow(std::move(row));
+        }
+      }
+
+      UpdateColumnNames();
+      UpdateRowNames();
+      EncodeDictionaryColumns();
+    }
+
+    static inline size_t GetSnapshotPadded(const size_t pSize)
+    {
+      return (pSize + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+    }
+
+    // Flags the characters requiring a cell to be quoted when written, i.e. separator, quote,
+    // space and linebreak characters.
+    struct QuoteTable
+    {
+      explicit QuoteTable(const SeparatorParams& pSeparatorParams)
+        : mNeedsQuote()
+      {
+        mNeedsQuote[static_cast<unsigned char>(pSeparatorParams.mSeparator)] = true;
+        mNeedsQuote[static_cast<unsigned char>(pSeparatorParams.mQuoteChar)] = true;
+        mNeedsQuote[static_cast<unsigned char>(' ')] = true;
+        mNeedsQuote[static_cast<unsigned char>('\n')] = true;
+        mNeedsQuote[static_cast<unsigned char>('\r')] = true;
+      }
+
+      bool mNeedsQuote[256];
+    };
+
+    // Appends a cell, quoted and with quote characters escaped if needed, to pOut. The cell is
+    // scanned once, as characters preceding the first one requiring quoting are not quotes.
+    static void AppendCell(const std::string& pCell, const SeparatorParams& pSeparatorParams,
+                           const QuoteTable& pQuoteTable, std::string& pOut)
+    {
+      if (!pSeparatorParams.mAutoQuote)
+      {
+        pOut += pCell;
+        return;
+      }
+
+      const char* begin = pCell.data();
+      const char* end = begin + pCell.size();
+      const char* pos = begin;
+      while ((pos < end) && !pQuoteTable.mNeedsQuote[static_cast<unsigned char>(*pos)])
+      {
+        ++pos;
+      }
+
+      if (pos == end)
+      {
+        pOut.append(begin, end);
+        return;
+      }
+
+      // escape quotes in string
+      const char quoteChar = pSeparatorParams.mQuoteChar;
+      pOut += quoteChar;
+      while ((pos = std::find(pos, end, quoteChar)) != end)
+      {
+        ++pos;
+        pOut.append(begin, pos);
+        pOut += quoteChar;
+        begin = pos;
+      }
+      pOut.append(begin, end);
+      pOut += quoteChar;
+    }
+
+    static void WriteBOM(std::ostream& pStream, const bool pIsUtf16, const bool pIsLE, const bool pHasUtf8BOM)
+    {
+      if (pIsUtf16)
+      {
+        std::string bom;
+        AppendUtf16(0x0000feff, pIsLE, bom);
+        pStream.write(bom.data(), static_cast<std::streamsize>(bom.size()));
+      }
+      else if (pHasUtf8BOM)
+      {
+        pStream.write(s_Utf8BOM.data(), 3);
+      }
+    }
+
+    // Writes and clears the UTF-8 data of pBuffer, which must end on a complete code point,
+    // transcoding it to UTF-16 in pUtf16 when requested.
+    static void WriteBuffer(std::ostream& pStream, const bool pIsUtf16, const bool pIsLE, std::string& pBuffer,
+                            std::string& pUtf16)
+    {
+      if (pIsUtf16)
+      {
+        pUtf16.clear();
+        AppendUtf8AsUtf16(pBuffer, pIsLE, pUtf16);
+        pStream.write(pUtf16.data(), static_cast<std::streamsize>(pUtf16.size()));
+      }
+      else
+      {
+        pStream.write(pBuffer.data(), static_cast<std::streamsize>(pBuffer.size()));
+      }
+
+      pBuffer.clear();
+    }
+
+    size_t GetDataRowCount() const
+    {
+      if (mLayout == StorageLayout::Buffer)
+      {
+        return mCellBuffer.GetRowCount();
+      }
+      else if (mLayout == StorageLayout::ColumnMajor)
+      {
+        return mColumnStore.GetRowCount();
+      }
+      else
+      {
+        return mData.size();
+      }
+    }
+
+    size_t GetDataRowSize(const size_t pDataRowIdx) const
+    {
+      if (mLayout == StorageLayout::Buffer)
+      {
+        return mCellBuffer.GetRowSize(pDataRowIdx);
+      }
+      else if (mLayout == StorageLayout::ColumnMajor)
+      {
+        return mColumnStore.GetRowSize(pDataRowIdx);
+      }
+      else
+      {
+        return mData.at(pDataRowIdx).size();
+      }
+    }
+
+    // Returns a reference to the cell, which for layouts not storing cells as std::string is
+    // copied into pCell. Passing the same pCell for consecutive calls reuses its capacity.
+    const std::string& GetDataCell(const size_t pDataRowIdx, const size_t pDataColumnIdx, std::string& pCell) const
+    {
+      if (mLayout == StorageLayout::Buffer)
+      {
+        mCellBuffer.GetCell(pDataRowIdx, pDataColumnIdx, pCell);
+        return pCell;
+      }
+      else if (mLayout == StorageLayout::ColumnMajor)
+      {
+        return mColumnStore.GetCell(pDataRowIdx, pDataColumnIdx);
+      }
+      else
+      {
+        return mData.at(pDataRowIdx).at(pDataColumnIdx);
+      }
+    }
+
+    // The modification helpers below require a layout supporting modification, see
+    // ConvertToColumnModifiable().
+    std::string& GetDataCell(const size_t pDataRowIdx, const size_t pDataColumnIdx)
+    {
+      if (mLayout == StorageLayout::ColumnMajor)
+      {
+        return mColumnStore.GetCell(pDataRowIdx, pDataColumnIdx);
+      }
+
+      return mData.at(pDataRowIdx).at(pDataColumnIdx);
+    }
+
+    void ResizeDataRow(const size_t pDataRowIdx, const size_t pSize)
+    {
+      if (mLayout == StorageLayout::ColumnMajor)
+      {
+        mColumnStore.ResizeRow(pDataRowIdx, pSize);
+      }
+      else
+      {
+        mData.at(pDataRowIdx).resize(pSize);
+      }
+    }
+
+    void AppendDataRow(const std::vector<std::string>& pRow)
+    {
+      if (mLayout == StorageLayout::Buffer)
+      {
+        mCellBuffer.AppendRow(pRow);
+      }
+      else if (mLayout == StorageLayout::ColumnMajor)
+      {
+        mColumnStore.AppendRow(pRow);
+      }
+      else
+      {
+        mData.push_back(pRow);
+      }
+    }
+
+    template<typename T>
+    void SetDataCell(const size_t pDataColumnIdx, const size_t pDataRowIdx, const T& pCell)
+    {
+      InvalidateColumnCache(pDataColumnIdx, (pDataRowIdx + 1) > GetDataRowCount());
+      ConvertToColumnModifiable();
+      while ((pDataRowIdx + 1) > GetDataRowCount())
+      {
+        std::vector<std::string> row;
+        row.resize(GetDataColumnCount());
+        AppendDataRow(row);
+      }
+
+      if ((pDataColumnIdx + 1) > GetDataColumnCount())
+      {
+        for (size_t rowIdx = GetColumnNameRowIndex(); rowIdx < GetDataRowCount(); ++rowIdx)
+        {
+          ResizeDataRow(rowIdx, pDataColumnIdx + 1);
+        }
+      }
+
+      std::string str;
+      Converter<T> converter(mConverterParams);
+      converter.ToStr(pCell, str);
+      GetDataCell(pDataRowIdx, pDataColumnIdx) = str;
+    }
+
+    template<typename T, typename InputIt>
+    std::vector<std::string> ToDataRow(InputIt pFirst, InputIt pLast) const
+    {
+      std::vector<std::string> row;
+      if (pFirst == pLast)
+      {
+        row.resize(GetDataColumnCount());
+      }
+      else
+      {
+        row.resize(GetDataColumnIndex(static_cast<size_t>(std::distance(pFirst, pLast))));
+        Converter<T> converter(mConverterParams);
+        size_t dataColumnIdx = GetDataColumnIndex(0);
+        for (InputIt itCol = pFirst; itCol != pLast; ++itCol)
+        {
+          ToDataStr(converter, *itCol, row.at(dataColumnIdx++));
+        }
+      }
+
+      return row;
+    }
+
+    // Converts a cell value to its string representation, moving strings rather than copying them.
+    template<typename T>
+    static void ToDataStr(const Converter<T>& pConverter, const T& pVal, std::string& pStr)
+    {
+      pConverter.ToStr(pVal, pStr);
+    }
+
+    static void ToDataStr(const Converter<std::string>& /*pConverter*/, std::string&& pVal, std::string& pStr)
+    {
+      pStr = std::move(pVal);
+    }
+
+    template<typename T, typename InputIt>
+    void SetColumnCells(const size_t pColumnIdx, InputIt pFirst, InputIt pLast)
+    {
+      ConvertToColumnModifiable();
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      const size_t columnSize = static_cast<size_t>(std::distance(pFirst, pLast));
+      InvalidateColumnCache(dataColumnIdx, GetDataRowIndex(columnSize) > GetDataRowCount());
+
+      while (GetDataRowIndex(columnSize) > GetDataRowCount())
+      {
+        std::vector<std::string> row;
+        row.resize(GetDataColumnCount());
+        AppendDataRow(row);
+      }
+
+      if ((dataColumnIdx + 1) > GetDataColumnCount())
+      {
+        for (size_t dataRowIdx = GetColumnNameRowIndex(); dataRowIdx < GetDataRowCount(); ++dataRowIdx)
+        {
+          ResizeDataRow(dataRowIdx, GetDataColumnIndex(dataColumnIdx + 1));
+        }
+      }
+
+      Converter<T> converter(mConverterParams);
+      size_t dataRowIdx = GetDataRowIndex(0);
+      for (InputIt itRow = pFirst; itRow != pLast; ++itRow)
+      {
+        std::string str;
+        ToDataStr(converter, *itRow, str);
+        GetDataCell(dataRowIdx++, dataColumnIdx) = std::move(str);
+      }
+    }
+
+    template<typename T, typename InputIt>
+    void SetRowCells(const size_t pRowIdx, InputIt pFirst, InputIt pLast)
+    {
+      InvalidateColumnCache();
+      ConvertToRowMajor();
+      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      const size_t rowSize = static_cast<size_t>(std::distance(pFirst, pLast));
+
+      while ((dataRowIdx + 1) > GetDataRowCount())
+      {
+        std::vector<std::string> row;
+        row.resize(GetDataColumnCount());
+        mData.push_back(row);
+      }
+
+      if (rowSize > GetDataColumnCount())
+      {
+        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        {
+          if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
+          {
+            itRow->resize(GetDataColumnIndex(rowSize));
+          }
+        }
+      }
+
+      Converter<T> converter(mConverterParams);
+      std::vector<std::string>& row = mData.at(dataRowIdx);
+      size_t dataColumnIdx = GetDataColumnIndex(0);
+      for (InputIt itCol = pFirst; itCol != pLast; ++itCol)
+      {
+        std::string str;
+        ToDataStr(converter, *itCol, str);
+        row.at(dataColumnIdx++) = std::move(str);
+      }
+    }
+
+    template<typename T, typename InputIt>
+    std::vector<std::string> ToDataColumn(InputIt pFirst, InputIt pLast) const
+    {
+      std::vector<std::string> column;
+      if (pFirst == pLast)
+      {
+        column.resize(GetDataRowCount());
+      }
+      else
+      {
+        column.resize(GetDataRowIndex(static_cast<size_t>(std::distance(pFirst, pLast))));
+        Converter<T> converter(mConverterParams);
+        size_t dataRowIdx = GetDataRowIndex(0);
+        for (InputIt itRow = pFirst; itRow != pLast; ++itRow)
+        {
+          ToDataStr(converter, *itRow, column.at(dataRowIdx++));
+        }
+      }
+
+      return column;
+    }
+
+    void InsertDataColumn(const size_t pColumnIdx, std::vector<std::string>&& pColumn, const std::string& pColumnName)
+    {
+      if (!pColumnName.empty() && (mLabelParams.mColumnNameIdx < 0))
+      {
+        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+      }
+
+      // rows appended for a column longer than the document are checked as well
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      const size_t rowCount = GetDataRowCount();
+      const size_t appendedRowSize = std::max<size_t>(static_cast<size_t>(mLabelParams.mColumnNameIdx + 1),
+                                                      GetDataColumnCount());
+      for (size_t dataRowIdx = GetColumnNameRowIndex(); dataRowIdx < std::max(rowCount, pColumn.size()); ++dataRowIdx)
+      {
+        if (dataColumnIdx > ((dataRowIdx < rowCount) ? GetDataRowSize(dataRowIdx) : appendedRowSize))
+        {
+          const std::string errStr = "column out of range: " +
+            std::to_string(pColumnIdx) + " (on row " +
+            std::to_string(dataRowIdx) +
+            ")";
+          throw std::out_of_range(errStr);
+        }
+      }
+
+      mColumnGeneration = NextGeneration();
+      ConvertToColumnModifiable();
+      const bool hadColumnNames = HasColumnNames();
+      if (pColumn.size() > rowCount)
+      {
+        InvalidateColumnCache();
+      }
+
+      while (pColumn.size() > GetDataRowCount())
+      {
+        std::vector<std::string> row;
+        row.resize(appendedRowSize);
+        AppendDataRow(row);
+      }
+
+      ShiftColumnCache(dataColumnIdx, 1);
+      if (mLayout == StorageLayout::ColumnMajor)
+      {
+        mColumnStore.InsertColumn(dataColumnIdx, GetColumnNameRowIndex(), pColumn);
+      }
+      else
+      {
+        for (size_t rowIdx = GetColumnNameRowIndex(); rowIdx < mData.size(); ++rowIdx)
+        {
+          std::vector<std::string>& row = mData[rowIdx];
+          row.insert(row.begin() + static_cast<std::ptrdiff_t>(dataColumnIdx), std::move(pColumn.at(rowIdx)));
+        }
+      }
+
+      if (hadColumnNames)
+      {
+        InsertColumnName(dataColumnIdx);
+      }
+      else
+      {
+        UpdateColumnNames();
+      }
+
+      if (!pColumnName.empty())
+      {
+        SetColumnName(pColumnIdx, pColumnName);
+      }
+    }
+
+    void InsertDataRow(const size_t pRowIdx, std::vector<std::string>&& pRow, const std::string& pRowName)
+    {
+      if (!pRowName.empty() && (mLabelParams.mRowNameIdx < 0))
+      {
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+      }
+
+      mRowGeneration = NextGeneration();
+      InvalidateColumnCache();
+      ConvertToRowMajor();
+      const size_t rowIdx = GetDataRowIndex(pRowIdx);
+      const size_t rowCount = GetDataRowCount();
+      const bool hadRowNames = HasRowNames();
+
+      while (rowIdx > GetDataRowCount())
+      {
+        std::vector<std::string> tempRow;
+        tempRow.resize(GetDataColumnCount());
+        mData.push_back(tempRow);
+      }
+
+      mData.insert(mData.begin() + static_cast<std::ptrdiff_t>(rowIdx), std::move(pRow));
+
+      if (!hadRowNames)
+      {
+        UpdateRowNames();
+      }
+      else if (rowIdx >= rowCount)
+      {
+        for (size_t dataRowIdx = rowCount; dataRowIdx < GetDataRowCount(); ++dataRowIdx)
+        {
+          InsertRowName(dataRowIdx, true /* pIsAppended */);
+        }
+      }
+      else
+      {
+        InsertRowName(rowIdx, false /* pIsAppended */);
+      }
+
+      if (!pRowName.empty())
+      {
+        SetRowName(pRowIdx, pRowName);
+      }
+    }
+
+    void RemoveDataRows(const std::vector<bool>& pIsRemoved)
+    {
+      mRowGeneration = NextGeneration();
+      InvalidateColumnCache();
+      ConvertToRowMajor();
+      const size_t firstDataRowIdx = GetDataRowIndex(0);
+      size_t keptDataRowIdx = firstDataRowIdx;
+      for (size_t dataRowIdx = firstDataRowIdx; dataRowIdx < mData.size(); ++dataRowIdx)
+      {
+        const size_t rowIdx = dataRowIdx - firstDataRowIdx;
+        if ((rowIdx < pIsRemoved.size()) && pIsRemoved[rowIdx])
+        {
+          continue;
+        }
+
+        if (keptDataRowIdx != dataRowIdx)
+        {
+          mData[keptDataRowIdx].swap(mData[dataRowIdx]);
+        }
+        ++keptDataRowIdx;
+      }
+
+      mData.resize(std::max(keptDataRowIdx, std::min(firstDataRowIdx, mData.size())));
+      UpdateRowNames();
+    }
+
+    template<typename T, typename OutputIt>
+    void ConvertColumn(const size_t pColumnIdx, OutputIt pColumn) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      Converter<T> converter(mConverterParams);
+      std::string cell;
+      for (size_t dataRowIdx = GetDataRowIndex(0); dataRowIdx < GetDataRowCount(); ++dataRowIdx)
+      {
+        const size_t rowSize = GetDataRowSize(dataRowIdx);
+        if (dataColumnIdx < rowSize)
+        {
+          T val;
+          converter.ToVal(GetDataCell(dataRowIdx, dataColumnIdx, cell), val);
+          *pColumn++ = val;
+        }
+        else
+        {
+          const std::string errStr = "requested column index " +
+            std::to_string(pColumnIdx) + " >= " +
+            std::to_string(rowSize - GetDataColumnIndex(0)) +
+            " (number of columns on row index " +
+            std::to_string(static_cast<std::ptrdiff_t>(dataRowIdx) -
+                           (mLabelParams.mColumnNameIdx + 1)) + ")";
+          throw std::out_of_range(errStr);
+        }
+      }
+    }
+
+    template<typename T, typename OutputIt>
+    void ConvertRow(const size_t pDataRowIdx, OutputIt pRow) const
+    {
+      Converter<T> converter(mConverterParams);
+      std::string cell;
+      const size_t rowSize = GetDataRowSize(pDataRowIdx);
+      for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < rowSize; ++dataColumnIdx)
+      {
+        T val;
+        converter.ToVal(GetDataCell(pDataRowIdx, dataColumnIdx, cell), val);
+        *pRow++ = val;
+      }
+    }
+
+    // Returns the number of cells on a row, excluding the row label.
+    size_t GetRowCellCount(const size_t pDataRowIdx) const
+    {
+      const size_t rowSize = GetDataRowSize(pDataRowIdx);
+      return (rowSize > GetDataColumnIndex(0)) ? (rowSize - GetDataColumnIndex(0)) : 0;
+    }
+
+    static void CheckOutputSize(const size_t pRequiredSize, const size_t pSize)
+    {
+      if (pSize < pRequiredSize)
+      {
+        const std::string errStr = "output size " + std::to_string(pSize) + " < required size " +
+          std::to_string(pRequiredSize);
+        throw std::out_of_range(errStr);
+      }
+    }
+
+    template<typename T>
+    const std::vector<T>& GetCachedColumn(const size_t pColumnIdx) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      for (const CachedColumn& cachedColumn : mColumnCache)
+      {
+        if ((cachedColumn.mDataColumnIdx == dataColumnIdx) && (cachedColumn.mTypeKey == GetTypeKey<T>()))
+        {
+          ++mColumnCacheHits;
+          return *static_cast<const std::vector<T>*>(cachedColumn.mValues.get());
+        }
+      }
+
+      ++mColumnCacheMisses;
+      const std::shared_ptr<std::vector<T>> column = std::make_shared<std::vector<T>>();
+      column->reserve(GetRowCount());
+      ConvertColumn<T>(pColumnIdx, std::back_inserter(*column));
+      mColumnCache.push_back(CachedColumn{ dataColumnIdx, GetTypeKey<T>(), column });
+      return *column;
+    }
+
+    void InvalidateColumnCache()
+    {
+      mColumnCache.clear();
+    }
+
+    // Drops cached columns affected by a modification of the specified data column, or all cached
+    // columns when the modification appends rows.
+    void InvalidateColumnCache(const size_t pDataColumnIdx, const bool pIsAppendingRows)
+    {
+      if (pIsAppendingRows)
+      {
+        InvalidateColumnCache();
+        return;
+      }
+
+      auto isAffected = [&](const CachedColumn& pCachedColumn)
+      {
+        return pCachedColumn.mDataColumnIdx == pDataColumnIdx;
+      };
+      mColumnCache.erase(std::remove_if(mColumnCache.begin(), mColumnCache.end(), isAffected), mColumnCache.end());
+    }
+
+    // Keeps cached columns valid across insertion (pOffset 1) or removal (pOffset -1) of the
+    // specified data column.
+    void ShiftColumnCache(const size_t pDataColumnIdx, const int pOffset)
+    {
+      if (pOffset < 0)
+      {
+        InvalidateColumnCache(pDataColumnIdx, false);
+      }
+
+      for (CachedColumn& cachedColumn : mColumnCache)
+      {
+        if ((cachedColumn.mDataColumnIdx > pDataColumnIdx) ||
+            ((cachedColumn.mDataColumnIdx == pDataColumnIdx) && (pOffset > 0)))
+        {
+          cachedColumn.mDataColumnIdx = static_cast<size_t>(static_cast<std::ptrdiff_t>(cachedColumn.mDataColumnIdx) +
+                                                            pOffset);
+        }
+      }
+    }
+
+    template<typename T>
+    static const void* GetTypeKey()
+    {
+      static const char key = 0;
+      return &key;
+    }
+
+    void CheckRef(const ColumnRef& pColumnRef) const
+    {
+      if (!IsValid(pColumnRef))
+      {
+        throw std::out_of_range("column reference invalidated");
+      }
+    }
+
+    void CheckRef(const RowRef& pRowRef) const
+    {
+      if (!IsValid(pRowRef))
+      {
+        throw std::out_of_range("row reference invalidated");
+      }
+    }
+
+    // Returns the index of the first row holding column cells, i.e. the column name row if any.
+    size_t GetColumnNameRowIndex() const
+    {
+      return static_cast<size_t>((mLabelParams.mColumnNameIdx >= 0) ? mLabelParams.mColumnNameIdx : 0);
+    }
+
+    size_t GetDataColumnCount() const
+    {
+      const size_t firstDataRow = GetColumnNameRowIndex();
+      return (GetDataRowCount() > firstDataRow) ? GetDataRowSize(firstDataRow) : 0;
+    }
+
+    // Reserves storage for the data to be parsed, with the row count estimated from the
+    // linebreaks within a sample from the start of the data unless specified by LoadParams.
+    void ReserveParsedData(const char* pSample, const size_t pSampleLength, const size_t pLength)
+    {
+      const size_t sampleLength = std::min<size_t>(pSampleLength, 16 * 1024);
+      const size_t lineCount = static_cast<size_t>(std::count(pSample, pSample + sampleLength, '\n'));
+      const double rowLength = (lineCount > 0) ? (static_cast<double>(sampleLength) / static_cast<double>(lineCount))
+                                               : static_cast<double>(pLength);
+
+      size_t rowCount = mLoadParams.mRowCountHint;
+      if ((rowCount == 0) && (lineCount > 0))
+      {
+        // overestimate slightly, as growing beyond an underestimate doubles the storage
+        rowCount = static_cast<size_t>(1.125 * static_cast<double>(pLength) / rowLength);
+      }
+
+      const bool hasMaxRowCount =
+        (mLoadParams.mMaxRowCount < (std::numeric_limits<size_t>::max() - GetDataRowIndex(0)));
+      if (hasMaxRowCount)
+      {
+        rowCount = std::min(rowCount, GetDataRowIndex(0) + mLoadParams.mMaxRowCount);
+      }
+
+      // cell data of filtered rows and unselected columns is not stored, hence only rows
+      // skipped or beyond the maximum row count are accounted for when reserving it
+      if ((mLayout == StorageLayout::Buffer) && !mLoadParams.mRowFilter &&
+          mLoadParams.mColumnIndices.empty() && mLoadParams.mColumnNames.empty())
+      {
+        // unquoted and trimmed cell data is never larger than the input data
+        double length = static_cast<double>(pLength) - (static_cast<double>(mLoadParams.mSkipRowCount) * rowLength);
+        if (hasMaxRowCount)
+        {
+          length = std::min(length, 1.125 * static_cast<double>(GetDataRowIndex(0) + mLoadParams.mMaxRowCount) *
+                                    rowLength);
+        }
+        mCellBuffer.Reserve(static_cast<size_t>(std::max(length, 0.0)));
+      }
+
+      ReserveDataRows(rowCount);
+    }
+
+    void ReserveDataRows(const size_t pRowCount)
+    {
+      if (mLayout == StorageLayout::Buffer)
+      {
+        mCellBuffer.ReserveRows(pRowCount);
+      }
+      else if (mLayout == StorageLayout::ColumnMajor)
+      {
+        mColumnStore.ReserveRows(pRowCount);
+      }
+      else
+      {
+        mData.reserve(pRowCount);
+      }
+    }
+
+    // Adds the parsed cell to the row unless its field is not projected, and detects comment
+    // lines by their first field.
+    void TakeParsedCell(ParseState& pState)
+    {
+      const std::vector<bool>& fieldMask = pState.mFieldMask;
+      const size_t fieldIdx = pState.mFieldIdx++;
+      const bool isProjected = fieldMask.empty() || ((fieldIdx < fieldMask.size()) && fieldMask[fieldIdx]);
+      const bool isCommentCheck = (fieldIdx == 0) && mLineReaderParams.mSkipCommentLines;
+      if (!isProjected && !isCommentCheck)
+      {
+        return;
+      }
+
+      // the cell is cleared by the caller once taken, so it is decoded in place
+      std::string& cell = pState.mCell;
+      Trim(cell);
+      Unquote(cell);
+      if (isProjected)
+      {
+        CheckMaxCount(pState.mRow.size() + 1);
+        pState.mRow.push_back(cell);
+      }
+
+      if (isCommentCheck)
+      {
+        pState.mCommentLine = !cell.empty() && (cell[0] == mLineReaderParams.mCommentPrefix);
+      }
+    }
+
+    // Adds the parsed row to the Document, or defers it, leaving the row empty with capacity for
+    // a row of the same size.
+    void TakeParsedRow(ParseState& pState)
+    {
+      std::vector<std::string>& row = pState.mRow;
+      const size_t rowSize = row.size();
+      if (pState.mDeferRows)
+      {
+        pState.mRows.push_back(std::move(row));
+      }
+      else
+      {
+        AddParsedRow(std::move(row), !pState.mFieldMask.empty());
+
+        // fields named by the column label row are projected by the parser once resolved
+        if (pState.mFieldMask.empty() && !mProjectedFields.empty())
+        {
+          pState.mFieldMask = mProjectedFields;
+        }
+      }
+
+      row.clear();
+      row.reserve(rowSize);
+    }
+
+    // Adds the parsed row to the Document, projecting it unless done by the parser. Rows up to
+    // the column label row are held back until the projected fields named in it are resolved.
+    void AddParsedRow(std::vector<std::string>&& pRow, const bool pIsProjected)
+    {
+      if (mProjectionPending)
+      {
+        mPendingRows.push_back(std::move(pRow));
+        if (mPendingRows.size() > static_cast<size_t>(mLabelParams.mColumnNameIdx))
+        {
+          ResolveProjection();
+        }
+        return;
+      }
+
+      if (!pIsProjected && !mProjectedFields.empty())
+      {
+        ProjectRow(pRow);
+      }
+
+      if ((GetDataRowCount() >= GetDataRowIndex(0)) && !IsLoadedDataRow(pRow))
+      {
+        return;
+      }
+
+      StoreParsedRow(std::move(pRow));
+    }
+
+    // Applies the row range and filter of LoadParams to the next parsed data row, and flags the
+    // load as done once past the range.
+    bool IsLoadedDataRow(const std::vector<std::string>& pRow)
+    {
+      const size_t parsedDataRowIdx = mParsedDataRowCount++;
+      if (parsedDataRowIdx < mLoadParams.mSkipRowCount)
+      {
+        return false;
+      }
+
+      const size_t rangeRowIdx = parsedDataRowIdx - mLoadParams.mSkipRowCount;
+      if (rangeRowIdx >= mLoadParams.mMaxRowCount)
+      {
+        mLoadDone = true;
+        return false;
+      }
+
+      mLoadDone = ((rangeRowIdx + 1) == mLoadParams.mMaxRowCount);
+      return !mLoadParams.mRowFilter || mLoadParams.mRowFilter(pRow);
+    }
+
+    void InitLoad()
+    {
+      mParsedDataRowCount = 0;
+      mLoadDone = false;
+      std::vector<bool>().swap(mProjectedFields);
+      std::vector<std::vector<std::string>>().swap(mPendingRows);
+      mProjectionPending = !mLoadParams.mColumnNames.empty();
+      if (mProjectionPending)
+      {
+        if (mLabelParams.mColumnNameIdx < 0)
+        {
+          throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
+        }
+      }
+      else if (!mLoadParams.mColumnIndices.empty())
+      {
+        SetProjectedFields(std::vector<std::string>());
+      }
+    }
+
+    // Sets the fields to be kept, i.e. row label fields and the specified columns, with named
+    // columns looked up in the column label row.
+    void SetProjectedFields(const std::vector<std::string>& pColumnNameRow)
+    {
+      std::vector<bool> fields(GetDataColumnIndex(0), true);
+      auto addField = [&](const size_t pFieldIdx)
+      {
+        if (pFieldIdx >= fields.size())
+        {
+          fields.resize(pFieldIdx + 1, false);
+        }
+        fields[pFieldIdx] = true;
+      };
+
+      for (const size_t columnIdx : mLoadParams.mColumnIndices)
+      {
+        addField(GetDataColumnIndex(columnIdx));
+      }
+
+      for (const std::string& columnName : mLoadParams.mColumnNames)
+      {
+        // the last of duplicate names is used, like by GetColumnIdx()
+        const auto columnNameIt = std::find(pColumnNameRow.rbegin(), pColumnNameRow.rend(), columnName);
+        const size_t fieldEnd = static_cast<size_t>(pColumnNameRow.rend() - columnNameIt);
+        if (fieldEnd <= GetDataColumnIndex(0))
+        {
+          throw std::out_of_range("column not found: " + columnName);
+        }
+        addField(fieldEnd - 1);
+      }
+
+      mProjectedFields.swap(fields);
+    }
+
+    void ResolveProjection()
+    {
+      const size_t columnNameRowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
+      SetProjectedFields((columnNameRowIdx < mPendingRows.size()) ? mPendingRows[columnNameRowIdx]
+                                                                 : std::vector<std::string>());
+      mProjectionPending = false;
+      for (std::vector<std::string>& row : mPendingRows)
+      {
+        ProjectRow(row);
+        StoreParsedRow(std::move(row));
+      }
+      std::vector<std::vector<std::string>>().swap(mPendingRows);
+    }
+
+    void ProjectRow(std::vector<std::string>& pRow) const
+    {
+      size_t cellCount = 0;
+      for (size_t fieldIdx = 0; (fieldIdx < pRow.size()) && (fieldIdx < mProjectedFields.size()); ++fieldIdx)
+      {
+        if (mProjectedFields[fieldIdx])
+        {
+          pRow[cellCount++].swap(pRow[fieldIdx]);
+        }
+      }
+      pRow.resize(cellCount);
+    }
+
+    void StoreParsedRow(std::vector<std::string>&& pRow)
+    {
+      CheckMaxCount(GetDataRowCount() + 1);
+      if (mLayout == StorageLayout::RowMajor)
+      {
+        mData.push_back(std::move(pRow));
+      }
+      else
+      {
+        AppendDataRow(pRow);
+      }
+    }
+
+    // Converts the Document to a layout supporting modification of columns and cells, which
+    // column-major layout does natively.
+    void ConvertToColumnModifiable()
+    {
+      if (mLayout == StorageLayout::Buffer)
+      {
+        ConvertToRowMajor();
+      }
+    }
+
+    // Converts the Document to row-major layout, which is the only layout supporting
+    // modification of rows.
+    void ConvertToRowMajor()
+    {
+      if (mLayout == StorageLayout::RowMajor)
+      {
+        return;
+      }
+
+      std::vector<std::vector<std::string>> data(GetDataRowCount());
+      std::string cell;
+      for (size_t dataRowIdx = 0; dataRowIdx < data.size(); ++dataRowIdx)
+      {
+        std::vector<std::string>& row = data[dataRowIdx];
+        row.resize(GetDataRowSize(dataRowIdx));
+        for (size_t dataColumnIdx = 0; dataColumnIdx < row.size(); ++dataColumnIdx)
+        {
+          row[dataColumnIdx] = GetDataCell(dataRowIdx, dataColumnIdx, cell);
+        }
+      }
+
+      mData.swap(data);
+      mCellBuffer.Clear();
+      mColumnStore.Clear();
+      mLayout = StorageLayout::RowMajor;
+    }
+
+    inline size_t GetDataRowIndex(const size_t pRowIdx) const
+    {
+      const size_t firstDataRow =
+        static_cast<size_t>((mLabelParams.mColumnNameIdx + 1 >= 0) ? mLabelParams.mColumnNameIdx + 1 : 0);
+      return pRowIdx + firstDataRow;
+    }
+
+    inline size_t GetDataColumnIndex(const size_t pColumnIdx) const
+    {
+      const size_t firstDataColumn =
+        static_cast<size_t>((mLabelParams.mRowNameIdx + 1 >= 0) ? mLabelParams.mRowNameIdx + 1 : 0);
+      return pColumnIdx + firstDataColumn;
+    }
+
+    // Removes leading and trailing whitespace in place, if enabled.
+    void Trim(std::string& pStr) const
+    {
+      if (mSeparatorParams.mTrim)
+      {
+        const auto isNotSpace = [](unsigned char ch) { return !isspace(ch); };
+
+        // rtrim
+        pStr.erase(std::find_if(pStr.rbegin(), pStr.rend(), isNotSpace).base(), pStr.end());
+
+        // ltrim
+        pStr.erase(pStr.begin(), std::find_if(pStr.begin(), pStr.end(), isNotSpace));
+      }
+    }
+
+    // Removes start/end quotes and unescapes quotes in place, in a single pass.
+    void Unquote(std::string& pStr) const
+    {
+      const char quoteChar = mSeparatorParams.mQuoteChar;
+      if (mSeparatorParams.mAutoQuote && (pStr.size() >= 2) &&
+          (pStr.front() == quoteChar) && (pStr.back() == quoteChar))
+      {
+        // remove start/end quotes
+        pStr.pop_back();
+        pStr.erase(0, 1);
+
+        // unescape quotes in string, compacting the characters following the first quote
+        size_t inIdx = pStr.find(quoteChar);
+        if (inIdx == std::string::npos)
+        {
+          return;
+        }
+
+        size_t outIdx = inIdx;
+        const size_t size = pStr.size();
+        for (; inIdx < size; ++inIdx)
+        {
+          const char ch = pStr[inIdx];
+          pStr[outIdx++] = ch;
+          if ((ch == quoteChar) && ((inIdx + 1) < size) && (pStr[inIdx + 1] == quoteChar))
+          {
+            ++inIdx;
+          }
+        }
+        pStr.resize(outIdx);
+      }
+    }
+
+    int FindColumnIdx(const char* pColumnName, const size_t pLength) const
+    {
+      size_t dataColumnIdx = 0;
+      if ((mLabelParams.mColumnNameIdx >= 0) && mColumnNames.Find(pColumnName, pLength, dataColumnIdx))
+      {
+        return static_cast<int>(dataColumnIdx) - (mLabelParams.mRowNameIdx + 1);
+      }
+      return -1;
+    }
+
+    int FindRowIdx(const char* pRowName, const size_t pLength) const
+    {
+      size_t dataRowIdx = 0;
+      if ((mLabelParams.mRowNameIdx >= 0) && mRowNames.Find(pRowName, pLength, dataRowIdx))
+      {
+        return static_cast<int>(dataRowIdx) - (mLabelParams.mColumnNameIdx + 1);
+      }
+      return -1;
+    }
+
+    // Label indices are rebuilt upon load and bulk row insertion and removal, and updated upon
+    // each insertion or removal of a single row or column, so that const lookups do not modify
+    // the Document.
+    bool HasColumnNames() const
+    {
+      return (mLabelParams.mColumnNameIdx >= 0) &&
+             (static_cast<std::ptrdiff_t>(GetDataRowCount()) > mLabelParams.mColumnNameIdx);
+    }
+
+    bool HasRowNames() const
+    {
+      return (mLabelParams.mRowNameIdx >= 0) &&
+             (static_cast<std::ptrdiff_t>(GetDataRowCount()) > (mLabelParams.mColumnNameIdx + 1));
+    }
+
+    void UpdateColumnNames()
+    {
+      mColumnNames.Clear();
+      if (HasColumnNames())
+      {
+        const size_t labelRowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
+        const size_t labelRowSize = GetDataRowSize(labelRowIdx);
+        std::string cell;
+        mColumnNames.Reserve(labelRowSize);
+        for (size_t i = 0; i < labelRowSize; ++i)
+        {
+          mColumnNames.Add(GetDataCell(labelRowIdx, i, cell), i);
+        }
+      }
+    }
+
+    void UpdateRowNames()
+    {
+      mRowNames.Clear();
+      if (HasRowNames())
+      {
+        const size_t labelColumnIdx = static_cast<size_t>(mLabelParams.mRowNameIdx);
+        std::string cell;
+        mRowNames.Reserve(GetDataRowCount());
+        for (size_t i = 0; i < GetDataRowCount(); ++i)
+        {
+          // rows too short to hold a row label are left unnamed, but must still be counted
+          if (GetDataRowSize(i) > labelColumnIdx)
+          {
+            mRowNames.Add(GetDataCell(i, labelColumnIdx, cell), i);
+          }
+        }
+      }
+    }
+
+    // Adds the label of the data column to the column label index, shifting the indices at or
+    // after it unless the column was appended.
+    void InsertColumnName(const size_t pDataColumnIdx)
+    {
+      const size_t labelRowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
+      std::string cell;
+      const std::string& columnName = GetDataCell(labelRowIdx, pDataColumnIdx, cell);
+      if ((pDataColumnIdx + 1) == GetDataRowSize(labelRowIdx))
+      {
+        mColumnNames.Add(columnName, pDataColumnIdx);
+      }
+      else
+      {
+        mColumnNames.Insert(columnName, pDataColumnIdx);
+      }
+    }
+
+    void InsertRowName(const size_t pDataRowIdx, const bool pIsAppended)
+    {
+      const size_t labelColumnIdx = static_cast<size_t>(mLabelParams.mRowNameIdx);
+      if (GetDataRowSize(pDataRowIdx) <= labelColumnIdx)
+      {
+        if (!pIsAppended)
+        {
+          mRowNames.Insert(pDataRowIdx);
+        }
+        return;
+      }
+
+      std::string cell;
+      const std::string& rowName = GetDataCell(pDataRowIdx, labelColumnIdx, cell);
+      if (pIsAppended)
+      {
+        mRowNames.Add(rowName, pDataRowIdx);
+      }
+      else
+      {
+        mRowNames.Insert(rowName, pDataRowIdx);
+      }
+    }
+
+    // Sets the label index of a name shared by other labels to its last label before the given
+    // index, after the label at the index has been removed or renamed.
+    void ResetColumnName(const std::string& pColumnName, const size_t pDataColumnIdx)
+    {
+      const size_t labelRowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
+      std::string cell;
+      for (size_t i = std::min(pDataColumnIdx, GetDataRowSize(labelRowIdx)); i > 0; --i)
+      {
+        if (GetDataCell(labelRowIdx, i - 1, cell) == pColumnName)
+        {
+          mColumnNames.Set(pColumnName, i - 1);
+          return;
+        }
+      }
+
+      mColumnNames.Erase(pColumnName);
+    }
+
+    void ResetRowName(const std::string& pRowName, const size_t pDataRowIdx)
+    {
+      const size_t labelColumnIdx = static_cast<size_t>(mLabelParams.mRowNameIdx);
+      std::string cell;
+      for (size_t i = std::min(pDataRowIdx, GetDataRowCount()); i > 0; --i)
+      {
+        if ((GetDataRowSize(i - 1) > labelColumnIdx) && (GetDataCell(i - 1, labelColumnIdx, cell) == pRowName))
+        {
+          mRowNames.Set(pRowName, i - 1);
+          return;
+        }
+      }
+
+      mRowNames.Erase(pRowName);
+    }
+
+    // Unicode code point used in place of malformed input.
+    static const uint32_t s_ReplacementChar = 0x0000fffd;
+
+    // Reads the UTF-16 code unit at byte offset pIdx, which must be a valid offset
+    // of a complete code unit.
+    static uint32_t GetUtf16Unit(const char* pData, size_t pIdx, bool pIsLE)
+    {
+      const uint32_t byte0 = static_cast<unsigned char>(pData[pIdx]);
+      const uint32_t byte1 = static_cast<unsigned char>(pData[pIdx + 1]);
+      return pIsLE ? ((byte1 << 8) | byte0) : ((byte0 << 8) | byte1);
+    }
+
+    static void AppendUtf16Unit(uint32_t pUnit, bool pIsLE, std::string& pUtf16)
+    {
+      const char lowByte = static_cast<char>(pUnit & 0xff);
+      const char highByte = static_cast<char>((pUnit >> 8) & 0xff);
+      pUtf16 += pIsLE ? lowByte : highByte;
+      pUtf16 += pIsLE ? highByte : lowByte;
+    }
+
+    static void AppendUtf16(uint32_t pCodePoint, bool pIsLE, std::string& pUtf16)
+    {
+      if (pCodePoint >= 0x10000)
+      {
+        // encode as surrogate pair
+        const uint32_t offset = pCodePoint - 0x10000;
+        AppendUtf16Unit(0xd800 + (offset >> 10), pIsLE, pUtf16);
+        AppendUtf16Unit(0xdc00 + (offset & 0x3ff), pIsLE, pUtf16);
+      }
+      else
+      {
+        AppendUtf16Unit(pCodePoint, pIsLE, pUtf16);
+      }
+    }
+
+    static void AppendUtf8(uint32_t pCodePoint, std::string& pUtf8)
+    {
+      if (pCodePoint < 0x80)
+      {
+        pUtf8 += static_cast<char>(pCodePoint);
+      }
+      else if (pCodePoint < 0x800)
+      {
+        pUtf8 += static_cast<char>(0xc0 | (pCodePoint >> 6));
+        pUtf8 += static_cast<char>(0x80 | (pCodePoint & 0x3f));
+      }
+      else if (pCodePoint < 0x10000)
+      {
+        pUtf8 += static_cast<char>(0xe0 | (pCodePoint >> 12));
+        pUtf8 += static_cast<char>(0x80 | ((pCodePoint >> 6) & 0x3f));
+        pUtf8 += static_cast<char>(0x80 | (pCodePoint & 0x3f));
+      }
+      else
+      {
+        pUtf8 += static_cast<char>(0xf0 | (pCodePoint >> 18));
+        pUtf8 += static_cast<char>(0x80 | ((pCodePoint >> 12) & 0x3f));
+        pUtf8 += static_cast<char>(0x80 | ((pCodePoint >> 6) & 0x3f));
+        pUtf8 += static_cast<char>(0x80 | (pCodePoint & 0x3f));
+      }
+    }
+
+    // Converts UTF-16 encoded data (without byte order mark) to UTF-8. Surrogate pairs
+    // are combined into a single code point. Unpaired surrogates and a trailing odd byte
+    // are replaced with U+FFFD.
+    static std::string Utf16ToUtf8(const char* pData, size_t pSize, bool pIsLE)
+    {
+      std::string utf8;
+      utf8.reserve(pSize);
+
+      size_t idx = 0;
+      while ((idx + 1) < pSize)
+      {
+        uint32_t codePoint = GetUtf16Unit(pData, idx, pIsLE);
+        idx += 2;
+
+        if ((codePoint >= 0xd800) && (codePoint <= 0xdbff) && ((idx + 1) < pSize))
+        {
+          // high surrogate - combine with low surrogate, when present
+          const uint32_t lowSurrogate = GetUtf16Unit(pData, idx, pIsLE);
+          if ((lowSurrogate >= 0xdc00) && (lowSurrogate <= 0xdfff))
+          {
+            codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+            idx += 2;
+          }
+        }
+
+        if ((codePoint >= 0xd800) && (codePoint <= 0xdfff))
+        {
+          // unpaired surrogate
+          codePoint = s_ReplacementChar;
+        }
+
+        AppendUtf8(codePoint, utf8);
+      }
+
+      if (idx < pSize)
+      {
+        // trailing odd byte
+        AppendUtf8(s_ReplacementChar, utf8);
+      }
+
+      return utf8;
+    }
+
+    // Converts UTF-8 encoded data to UTF-16 appended to pUtf16. Code points outside the basic
+    // multilingual plane are encoded as surrogate pairs. Malformed input is replaced with U+FFFD.
+    static void AppendUtf8AsUtf16(const std::string& pUtf8, bool pIsLE, std::string& pUtf16)
+    {
+      pUtf16.reserve(pUtf16.size() + (pUtf8.size() * 2));
+
+      size_t idx = 0;
+      while (idx < pUtf8.size())
+      {
+        const uint32_t leadByte = static_cast<unsigned char>(pUtf8[idx]);
+        uint32_t codePoint = 0;
+        size_t seqLen = 0;
+
+        if (leadByte < 0x80)
+        {
+          codePoint = leadByte;
+          seqLen = 1;
+        }
+        else if ((leadByte & 0xe0) == 0xc0)
+        {
+          codePoint = leadByte & 0x1f;
+          seqLen = 2;
+        }
+        else if ((leadByte & 0xf0) == 0xe0)
+        {
+          codePoint = leadByte & 0x0f;
+          seqLen = 3;
+        }
+        else if ((leadByte & 0xf8) == 0xf0)
+        {
+          codePoint = leadByte & 0x07;
+          seqLen = 4;
+        }
+        else
+        {
+          // invalid lead byte
+          codePoint = s_ReplacementChar;
+          seqLen = 1;
+        }
+
+        if ((seqLen > 1) && ((idx + seqLen) <= pUtf8.size()))
+        {
+          for (size_t byteIdx = 1; byteIdx < seqLen; ++byteIdx)
+          {
+            const uint32_t contByte = static_cast<unsigned char>(pUtf8[idx + byteIdx]);
+            if ((contByte & 0xc0) != 0x80)
+            {
+              // invalid continuation byte
+              codePoint = s_ReplacementChar;
+              seqLen = 1;
+              break;
+            }
+
+            codePoint = (codePoint << 6) | (contByte & 0x3f);
+          }
+        }
+        else if (seqLen > 1)
+        {
+          // truncated sequence
+          codePoint = s_ReplacementChar;
+          seqLen = 1;
+        }
+
+        // reject out of range code points, surrogates and overlong sequences
+        static const uint32_t minCodePoint[5] = { 0, 0, 0x80, 0x800, 0x10000 };
+        if ((codePoint > 0x0010ffff) ||
+            ((codePoint >= 0xd800) && (codePoint <= 0xdfff)) ||
+            (codePoint < minCodePoint[seqLen]))
+        {
+          codePoint = s_ReplacementChar;
+        }
+
+        AppendUtf16(codePoint, pIsLE, pUtf16);
+        idx += seqLen;
+      }
+    }
+
+  private:
+    friend class Reader;
+    friend class IndexedReader;
+    friend class Writer;
+
+    std::string mPath;
+    LabelParams mLabelParams;
+    SeparatorParams mSeparatorParams;
+    ConverterParams mConverterParams;
+    LineReaderParams mLineReaderParams;
+    LoadParams mLoadParams;
+    StorageParams mStorageParams;
+    StorageLayout mLayout;
+    std::vector<std::vector<std::string>> mData;
+    CellBuffer mCellBuffer;
+    ColumnStore mColumnStore;
+    LabelIndex mColumnNames;
+    LabelIndex mRowNames;
+    bool mIsUtf16 = false;
+    bool mIsLE = false;
+    bool mHasUtf8BOM = false;
+
+    // fields of each line kept as cells when loading specified columns, and rows held back until
+    // the column label row is parsed if the fields are not yet resolved
+    std::vector<bool> mProjectedFields;
+    bool mProjectionPending = false;
+    std::vector<std::vector<std::string>> mPendingRows;
+
+    // number of data rows parsed, and whether the rows to load have all been parsed
+    size_t mParsedDataRowCount = 0;
+    bool mLoadDone = false;
+
+    // replaced when column or row indices shift, invalidating ColumnRef and RowRef
+    size_t mColumnGeneration = NextGeneration();
+    size_t mRowGeneration = NextGeneration();
+
+    // converted column, identified by data column index and value type, held by the column cache
+    struct CachedColumn
+    {
+      size_t mDataColumnIdx;
+      const void* mTypeKey;
+      std::shared_ptr<const void> mValues;
+    };
+
+    mutable std::vector<CachedColumn> mColumnCache;
+    mutable size_t mColumnCacheHits = 0;
+    mutable size_t mColumnCacheMisses = 0;
+  };
+
+  /**
+   * @brief     Class representing a forward-only reader of CSV rows. Input data is parsed in
+   *            chunks by the same parser as Document, and rows are handed out one at a time
+   *            without being stored, so memory usage is bounded by the chunk size and the
+   *            largest row rather than by the size of the input.
+   */
+  class Reader
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing CSV-file to read.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     */
+    explicit Reader(const std::string& pPath,
+                    const LabelParams& pLabelParams = LabelParams(),
+                    const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                    const ConverterParams& pConverterParams = ConverterParams(),
+                    const LineReaderParams& pLineReaderParams = LineReaderParams())
+      : mParser(std::string(), pLabelParams, pSeparatorParams, pConverterParams, pLineReaderParams)
+      , mLabelParams(pLabelParams)
+      , mConverterParams(pConverterParams)
+      , mFile()
+      , mStream(mFile)
+      , mBuffer(s_BufferLength)
+      , mBufferUsed(0)
+      , mUtf8()
+      , mState(pSeparatorParams)
+      , mStateRowIdx(0)
+      , mIsFirstChunk(true)
+      , mIsEnd(false)
+      , mIsUtf16(false)
+      , mIsLE(false)
+      , mRow()
+      , mColumnNameRow()
+      , mColumnNames()
+    {
+      mFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      mFile.open(pPath, std::ios::binary);
+
+      // reaching end of file while reading a chunk is expected
+      mFile.exceptions(std::ifstream::badbit);
+      ReadColumnNames();
+    }
+
+    /**
+     * @brief   Constructor
+     * @param   pStream               specifies a binary input stream to read CSV data from.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     */
+    explicit Reader(std::istream& pStream,
+                    const LabelParams& pLabelParams = LabelParams(),
+                    const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                    const ConverterParams& pConverterParams = ConverterParams(),
+                    const LineReaderParams& pLineReaderParams = LineReaderParams())
+      : mParser(std::string(), pLabelParams, pSeparatorParams, pConverterParams, pLineReaderParams)
+      , mLabelParams(pLabelParams)
+      , mConverterParams(pConverterParams)
+      , mFile()
+      , mStream(pStream)
+      , mBuffer(s_BufferLength)
+      , mBufferUsed(0)
+      , mUtf8()
+      , mState(pSeparatorParams)
+      , mStateRowIdx(0)
+      , mIsFirstChunk(true)
+      , mIsEnd(false)
+      , mIsUtf16(false)
+      , mIsLE(false)
+      , mRow()
+      , mColumnNameRow()
+      , mColumnNames()
+    {
+      ReadColumnNames();
+    }
+
+    /**
+     * @brief   Read the next data row, replacing the current row. Rows preceding and including
+     *          the column label row are skipped.
+     * @returns true if a row was read, false if the end of the data has been reached.
+     */
+    bool ReadRow()
+    {
+      return ReadParsedRow(mRow);
+    }
+
+    /**
+     * @brief   Get number of data columns of the current row, excluding the row label column.
+     * @returns column count.
+     */
+    size_t GetColumnCount() const
+    {
+      const size_t firstDataColumn = GetDataColumnIndex(0);
+      return (mRow.size() > firstDataColumn) ? (mRow.size() - firstDataColumn) : 0;
+    }
+
+    /**
+     * @brief   Get column index by name. Resolving the index once, before reading rows, avoids
+     *          a name lookup per accessed cell.
+     * @param   pColumnName           column label name.
+     * @returns zero-based column index, or -1 if the column is not found.
+     */
+    int GetColumnIdx(const std::string& pColumnName) const
+    {
+      size_t dataColumnIdx = 0;
+      if (mColumnNames.Find(pColumnName.data(), pColumnName.size(), dataColumnIdx))
+      {
+        return static_cast<int>(dataColumnIdx) - (mLabelParams.mRowNameIdx + 1);
+      }
+      return -1;
     }
 
     /**
-     * @brief   Get number of data rows (excluding label rows).
-     * @returns row count.
+     * @brief   Get column names
+     * @returns vector of column names.
      */
-    size_t GetRowCount() const
+    std::vector<std::string> GetColumnNames() const
     {
-      const std::ptrdiff_t count = static_cast<std::ptrdiff_t>(mData.size()) -
-        (mLabelParams.mColumnNameIdx + 1);
-      return (count >= 0) ? static_cast<size_t>(count) : 0;
+      std::vector<std::string> columnNames;
+      for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < mColumnNameRow.size();
+           ++dataColumnIdx)
+      {
+        columnNames.push_back(mColumnNameRow.at(dataColumnIdx));
+      }
+
+      return columnNames;
     }
 
     /**
-     * @brief   Get cell by index.
+     * @brief   Get cell of the current row by column index.
      * @param   pColumnIdx            zero-based column index.
-     * @param   pRowIdx               zero-based row index.
      * @returns cell data.
      */
     template<typename T>
-    T GetCell(const size_t pColumnIdx, const size_t pRowIdx) const
+    T GetCell(const size_t pColumnIdx) const
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-
       T val;
       Converter<T> converter(mConverterParams);
-      converter.ToVal(mData.at(dataRowIdx).at(dataColumnIdx), val);
+      converter.ToVal(GetDataCell(pColumnIdx), val);
       return val;
     }
 
     /**
-     * @brief   Get cell by index.
+     * @brief   Get cell of the current row by column index.
      * @param   pColumnIdx            zero-based column index.
-     * @param   pRowIdx               zero-based row index.
      * @param   pToVal                conversion function.
      * @returns cell data.
      */
     template<typename T>
-    T GetCell(const size_t pColumnIdx, const size_t pRowIdx, ConvFunc<T> pToVal) const
+    T GetCell(const size_t pColumnIdx, ConvFunc<T> pToVal) const
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-
       T val;
-      pToVal(mData.at(dataRowIdx).at(dataColumnIdx), val);
+      pToVal(GetDataCell(pColumnIdx), val);
       return val;
     }
 
     /**
-     * @brief   Get cell by name.
+     * @brief   Get cell of the current row by column name.
      * @param   pColumnName           column label name.
-     * @param   pRowName              row label name.
      * @returns cell data.
      */
     template<typename T>
-    T GetCell(const std::string& pColumnName, const std::string& pRowName) const
+    T GetCell(const std::string& pColumnName) const
     {
       const int columnIdx = GetColumnIdx(pColumnName);
       if (columnIdx < 0)
@@ -1213,263 +6661,308 @@ namespace rapidcsv
         throw std::out_of_range("column not found: " + pColumnName);
       }
 
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-
-      return GetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx));
+      return GetCell<T>(static_cast<size_t>(columnIdx));
     }
 
     /**
-     * @brief   Get cell by name.
-     * @param   pColumnName           column label name.
-     * @param   pRowName              row label name.
-     * @param   pToVal                conversion function.
-     * @returns cell data.
+     * @brief   Get the current row.
+     * @returns vector of row data, excluding the row label.
      */
     template<typename T>
-    T GetCell(const std::string& pColumnName, const std::string& pRowName, ConvFunc<T> pToVal) const
+    std::vector<T> GetRow() const
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
-      {
-        throw std::out_of_range("column not found: " + pColumnName);
-      }
-
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
-      {
-        throw std::out_of_range("row not found: " + pRowName);
-      }
-
-      return GetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx), pToVal);
+      std::vector<T> row;
+      GetRow<T>(row);
+      return row;
     }
 
     /**
-     * @brief   Get cell by column name and row index.
-     * @param   pColumnName           column label name.
-     * @param   pRowIdx               zero-based row index.
-     * @returns cell data.
+     * @brief   Get the current row into a caller-provided vector, reusing its capacity.
+     * @param   pRow                  vector replaced with the row data, excluding the row label.
      */
     template<typename T>
-    T GetCell(const std::string& pColumnName, const size_t pRowIdx) const
+    void GetRow(std::vector<T>& pRow) const
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      pRow.clear();
+      if (mRow.size() > GetDataColumnIndex(0))
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        pRow.reserve(mRow.size() - GetDataColumnIndex(0));
       }
 
-      return GetCell<T>(static_cast<size_t>(columnIdx), pRowIdx);
+      Converter<T> converter(mConverterParams);
+      for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < mRow.size(); ++dataColumnIdx)
+      {
+        T val;
+        converter.ToVal(mRow.at(dataColumnIdx), val);
+        pRow.push_back(val);
+      }
     }
 
     /**
-     * @brief   Get cell by column name and row index.
-     * @param   pColumnName           column label name.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pToVal                conversion function.
-     * @returns cell data.
+     * @brief   Get row name of the current row.
+     * @returns row name.
      */
-    template<typename T>
-    T GetCell(const std::string& pColumnName, const size_t pRowIdx, ConvFunc<T> pToVal) const
+    std::string GetRowName() const
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      if (mLabelParams.mRowNameIdx < 0)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
       }
 
-      return GetCell<T>(static_cast<size_t>(columnIdx), pRowIdx, pToVal);
+      return mRow.at(static_cast<size_t>(mLabelParams.mRowNameIdx));
     }
 
-    /**
-     * @brief   Get cell by column index and row name.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pRowName              row label name.
-     * @returns cell data.
-     */
-    template<typename T>
-    T GetCell(const size_t pColumnIdx, const std::string& pRowName) const
+  private:
+    void ReadColumnNames()
     {
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+      // rows preceding the column label row are not accessible, like for Document
+      for (int rowIdx = 0; rowIdx < mLabelParams.mColumnNameIdx; ++rowIdx)
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        if (!ReadParsedRow(mRow))
+        {
+          return;
+        }
       }
+      mRow.clear();
 
-      return GetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx));
+      if ((mLabelParams.mColumnNameIdx >= 0) && ReadParsedRow(mColumnNameRow))
+      {
+        mColumnNames.Reserve(mColumnNameRow.size());
+        for (size_t i = 0; i < mColumnNameRow.size(); ++i)
+        {
+          mColumnNames.Set(mColumnNameRow.at(i), i);
+        }
+      }
     }
 
-    /**
-     * @brief   Get cell by column index and row name.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pRowName              row label name.
-     * @param   pToVal                conversion function.
-     * @returns cell data.
-     */
-    template<typename T>
-    T GetCell(const size_t pColumnIdx, const std::string& pRowName, ConvFunc<T> pToVal) const
+    bool ReadParsedRow(std::vector<std::string>& pRow)
     {
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+      while (mStateRowIdx >= mState.mRows.size())
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        mState.mRows.clear();
+        mStateRowIdx = 0;
+        if (mIsEnd)
+        {
+          return false;
+        }
+
+        ParseChunk();
       }
 
-      return GetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx), pToVal);
+      pRow.swap(mState.mRows[mStateRowIdx++]);
+      return true;
     }
 
-    /**
-     * @brief   Set cell by index.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pCell                 cell data.
-     */
-    template<typename T>
-    void SetCell(const size_t pColumnIdx, const size_t pRowIdx, const T& pCell)
+    void ParseChunk()
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
+      mState.mDeferRows = true;
+      mStream.read(mBuffer.data() + mBufferUsed, static_cast<std::streamsize>(mBuffer.size() - mBufferUsed));
+      const size_t readLength = static_cast<size_t>(std::max<std::streamsize>(mStream.gcount(), 0));
+      size_t length = mBufferUsed + readLength;
+      const char* data = mBuffer.data();
+      mBufferUsed = 0;
+
+      if (mIsFirstChunk)
+      {
+        mIsFirstChunk = false;
+        if (Document::IsUtf16BOM(data, length))
+        {
+          mIsUtf16 = true;
+          mIsLE = (data[0] == '\xff');
+          data += 2;
+          length -= 2;
+        }
+        else if ((length >= 3) && std::equal(s_Utf8BOM.begin(), s_Utf8BOM.end(), data))
+        {
+          data += 3;
+          length -= 3;
+        }
+      }
 
-      while ((dataRowIdx + 1) > GetDataRowCount())
+      if (readLength == 0)
       {
-        std::vector<std::string> row;
-        row.resize(GetDataColumnCount());
-        mData.push_back(row);
+        mIsEnd = true;
       }
 
-      if ((dataColumnIdx + 1) > GetDataColumnCount())
+      if (mIsUtf16)
       {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
+        // keep a trailing high surrogate until the next chunk, which may hold its low surrogate
+        size_t carryLength = 0;
+        if (!mIsEnd && (length >= 2) && ((length % 2) == 0))
         {
-          if (std::distance(mData.begin(), itRow) >= mLabelParams.mColumnNameIdx)
-          {
-            itRow->resize(dataColumnIdx + 1);
-          }
+          const uint32_t unit = Document::GetUtf16Unit(data, length - 2, mIsLE);
+          carryLength = ((unit >= 0xd800) && (unit <= 0xdbff)) ? 2 : 0;
         }
+
+        mUtf8 = Document::Utf16ToUtf8(data, length - carryLength, mIsLE);
+        std::copy(data + length - carryLength, data + length, mBuffer.data());
+        mBufferUsed = carryLength;
+        data = mUtf8.data();
+        length = mUtf8.size();
       }
 
-      std::string str;
-      Converter<T> converter(mConverterParams);
-      converter.ToStr(pCell, str);
-      mData.at(dataRowIdx).at(dataColumnIdx) = str;
+      mParser.ParseBuffer(data, data + length, mState);
+      if (mIsEnd)
+      {
+        mParser.ParseLastRow(mState);
+      }
     }
 
-    /**
-     * @brief   Set cell by name.
-     * @param   pColumnName           column label name.
-     * @param   pRowName              row label name.
-     * @param   pCell                 cell data.
-     */
-    template<typename T>
-    void SetCell(const std::string& pColumnName, const std::string& pRowName, const T& pCell)
+    inline size_t GetDataColumnIndex(const size_t pColumnIdx) const
     {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
-      {
-        throw std::out_of_range("column not found: " + pColumnName);
-      }
+      return mParser.GetDataColumnIndex(pColumnIdx);
+    }
 
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+    const std::string& GetDataCell(const size_t pColumnIdx) const
+    {
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      if (dataColumnIdx >= mRow.size())
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        const std::string errStr = "column out of range: " + std::to_string(pColumnIdx);
+        throw std::out_of_range(errStr);
       }
 
-      SetCell<T>(static_cast<size_t>(columnIdx), static_cast<size_t>(rowIdx), pCell);
+      return mRow[dataColumnIdx];
     }
 
+  private:
+    static const size_t s_BufferLength = 64 * 1024;
+
+    Document mParser;
+    LabelParams mLabelParams;
+    ConverterParams mConverterParams;
+    std::ifstream mFile;
+    std::istream& mStream;
+    std::vector<char> mBuffer;
+    size_t mBufferUsed;
+    std::string mUtf8;
+    Document::ParseState mState;
+    size_t mStateRowIdx;
+    bool mIsFirstChunk;
+    bool mIsEnd;
+    bool mIsUtf16;
+    bool mIsLE;
+    std::vector<std::string> mRow;
+    std::vector<std::string> mColumnNameRow;
+    LabelIndex mColumnNames;
+  };
+
+  /**
+   * @brief     Class representing random access to rows of a CSV file without loading it. The
+   *            byte offset of every n:th row is recorded by a single parsing pass over the file and
+   *            saved to an index file for reuse. Requested rows are then parsed on demand, by
+   *            reading only the block of rows holding them, and recently used blocks are cached.
+   *            Only UTF-8 input is supported.
+   */
+  class IndexedReader
+  {
+  public:
     /**
-     * @brief   Set cell by column index and row name.
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pRowName              row label name.
-     * @param   pCell                 cell data.
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of an existing CSV-file to read.
+     * @param   pLabelParams          specifies which row and column should be treated as labels.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how invalid numbers (including empty strings) should be
+     *                                handled.
+     * @param   pLineReaderParams     specifies how special line formats should be treated.
+     * @param   pIndexParams          specifies how rows are indexed and cached.
      */
-    template<typename T>
-    void SetCell(const size_t pColumnIdx, const std::string& pRowName, const T& pCell)
+    explicit IndexedReader(const std::string& pPath,
+                           const LabelParams& pLabelParams = LabelParams(),
+                           const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                           const ConverterParams& pConverterParams = ConverterParams(),
+                           const LineReaderParams& pLineReaderParams = LineReaderParams(),
+                           const IndexParams& pIndexParams = IndexParams())
+      : mParser(std::string(), pLabelParams, pSeparatorParams, pConverterParams, pLineReaderParams)
+      , mLabelParams(pLabelParams)
+      , mConverterParams(pConverterParams)
+      , mIndexParams(pIndexParams)
+      , mFile()
+      , mFileSize(0)
+      , mFileTime(GetFileTime(pPath))
+      , mFileChecksum(0)
+      , mRowCount(0)
+      , mRowOffsets()
+      , mIsIndexLoaded(false)
+      , mColumnCount(0)
+      , mColumnNameRow()
+      , mColumnNames()
+      , mBlocks()
+      , mBlockUseCount(0)
+      , mBlockReadCount(0)
     {
-      const int rowIdx = GetRowIdx(pRowName);
-      if (rowIdx < 0)
+      mIndexParams.mRowStride = std::max<size_t>(mIndexParams.mRowStride, 1);
+      mIndexParams.mCacheBlockCount = std::max<size_t>(mIndexParams.mCacheBlockCount, 1);
+      if (mIndexParams.mIndexPath.empty())
       {
-        throw std::out_of_range("row not found: " + pRowName);
+        mIndexParams.mIndexPath = pPath + ".idx";
       }
 
-      SetCell<T>(pColumnIdx, static_cast<size_t>(rowIdx), pCell);
-    }
+      mFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+      mFile.open(pPath, std::ios::binary);
+      mFile.seekg(0, std::ios::end);
+      mFileSize = static_cast<uint64_t>(static_cast<std::streamoff>(mFile.tellg()));
 
-    /**
-     * @brief   Set cell by column name and row index.
-     * @param   pColumnName           column label name.
-     * @param   pRowIdx               zero-based row index.
-     * @param   pCell                 cell data.
-     */
-    template<typename T>
-    void SetCell(const std::string& pColumnName, const size_t pRowIdx, const T& pCell)
-    {
-      const int columnIdx = GetColumnIdx(pColumnName);
-      if (columnIdx < 0)
+      // reaching end of file while reading a block is expected
+      mFile.exceptions(std::ifstream::badbit);
+
+      mFileChecksum = GetFileChecksum();
+      mIsIndexLoaded = LoadIndex();
+      if (!mIsIndexLoaded)
       {
-        throw std::out_of_range("column not found: " + pColumnName);
+        BuildIndex();
+        if (mIndexParams.mSaveIndex)
+        {
+          SaveIndex();
+        }
       }
 
-      SetCell<T>(static_cast<size_t>(columnIdx), pRowIdx, pCell);
+      ReadColumnNames();
     }
 
     /**
-     * @brief   Get column name
-     * @param   pColumnIdx            zero-based column index.
-     * @returns column name.
+     * @brief   Determine whether the row index was loaded from the index file, rather than built
+     *          by parsing the CSV-file.
+     * @returns true if the index was loaded from the index file.
      */
-    std::string GetColumnName(const size_t pColumnIdx) const
+    bool IsIndexLoaded() const
     {
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-      if (mLabelParams.mColumnNameIdx < 0)
-      {
-        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
-      }
-
-      return mData.at(static_cast<size_t>(mLabelParams.mColumnNameIdx)).at(dataColumnIdx);
+      return mIsIndexLoaded;
     }
 
     /**
-     * @brief   Set column name
-     * @param   pColumnIdx            zero-based column index.
-     * @param   pColumnName           column name.
+     * @brief   Get number of data rows, excluding rows preceding and including the column label row.
+     * @returns row count.
      */
-    void SetColumnName(size_t pColumnIdx, const std::string& pColumnName)
+    size_t GetRowCount() const
     {
-      if (mLabelParams.mColumnNameIdx < 0)
-      {
-        throw std::out_of_range("column name row index < 0: " + std::to_string(mLabelParams.mColumnNameIdx));
-      }
-
-      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
-
-      // remove old name from map before adding new one
-      const size_t nameRowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
-      if ((nameRowIdx < mData.size()) && (dataColumnIdx < mData.at(nameRowIdx).size()))
-      {
-        const std::string oldName = mData.at(nameRowIdx).at(dataColumnIdx);
-        mColumnNames.erase(oldName);
-      }
-      mColumnNames[pColumnName] = dataColumnIdx;
+      const size_t firstRowIdx = GetFirstRowIndex();
+      return (mRowCount > firstRowIdx) ? static_cast<size_t>(mRowCount - firstRowIdx) : 0;
+    }
 
-      // increase table size if necessary:
-      const size_t rowIdx = static_cast<size_t>(mLabelParams.mColumnNameIdx);
-      if (rowIdx >= mData.size())
-      {
-        mData.resize(rowIdx + 1);
-      }
+    /**
+     * @brief   Get number of data columns of the column label row, or of the first row if there is
+     *          no column label row, excluding the row label column.
+     * @returns column count.
+     */
+    size_t GetColumnCount() const
+    {
+      return mColumnCount;
+    }
 
-      std::vector<std::string>& row = mData[rowIdx];
-      if (dataColumnIdx >= row.size())
+    /**
+     * @brief   Get column index by name.
+     * @param   pColumnName           column label name.
+     * @returns zero-based column index, or -1 if the column is not found.
+     */
+    int GetColumnIdx(const std::string& pColumnName) const
+    {
+      size_t dataColumnIdx = 0;
+      if (mColumnNames.Find(pColumnName.data(), pColumnName.size(), dataColumnIdx))
       {
-        row.resize(dataColumnIdx + 1);
+        return static_cast<int>(dataColumnIdx) - (mLabelParams.mRowNameIdx + 1);
       }
-
-      mData.at(static_cast<size_t>(mLabelParams.mColumnNameIdx)).at(dataColumnIdx) = pColumnName;
+      return -1;
     }
 
     /**
@@ -1478,689 +6971,560 @@ namespace rapidcsv
      */
     std::vector<std::string> GetColumnNames() const
     {
-      if (mLabelParams.mColumnNameIdx >= 0)
+      std::vector<std::string> columnNames;
+      for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < mColumnNameRow.size();
+           ++dataColumnIdx)
       {
-        const std::vector<std::string>& labelRow = mData.at(static_cast<size_t>(mLabelParams.mColumnNameIdx));
-        const size_t offset = static_cast<size_t>(mLabelParams.mRowNameIdx + 1);
-        if (offset <= labelRow.size())
-        {
-          return std::vector<std::string>(labelRow.begin() + static_cast<std::ptrdiff_t>(offset), labelRow.end());
-        }
+        columnNames.push_back(mColumnNameRow.at(dataColumnIdx));
       }
 
-      return std::vector<std::string>();
+      return columnNames;
     }
 
     /**
-     * @brief   Get row name
-     * @param   pRowIdx               zero-based column index.
-     * @returns row name.
+     * @brief   Get cell by index.
+     * @param   pColumnIdx            zero-based column index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns cell data.
      */
-    std::string GetRowName(const size_t pRowIdx) const
+    template<typename T>
+    T GetCell(const size_t pColumnIdx, const size_t pRowIdx) const
     {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-      if (mLabelParams.mRowNameIdx < 0)
+      const std::vector<std::string>& row = GetDataRow(pRowIdx);
+      const size_t dataColumnIdx = GetDataColumnIndex(pColumnIdx);
+      if (dataColumnIdx >= row.size())
       {
-        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+        const std::string errStr = "column out of range: " + std::to_string(pColumnIdx);
+        throw std::out_of_range(errStr);
       }
 
-      return mData.at(dataRowIdx).at(static_cast<size_t>(mLabelParams.mRowNameIdx));
+      T val;
+      Converter<T> converter(mConverterParams);
+      converter.ToVal(row[dataColumnIdx], val);
+      return val;
     }
 
     /**
-     * @brief   Set row name
+     * @brief   Get cell by column name and row index.
+     * @param   pColumnName           column label name.
      * @param   pRowIdx               zero-based row index.
-     * @param   pRowName              row name.
+     * @returns cell data.
      */
-    void SetRowName(size_t pRowIdx, const std::string& pRowName)
+    template<typename T>
+    T GetCell(const std::string& pColumnName, const size_t pRowIdx) const
     {
-      const size_t dataRowIdx = GetDataRowIndex(pRowIdx);
-
-      // remove old name from map before adding new one
-      if ((mLabelParams.mRowNameIdx >= 0) && (dataRowIdx < mData.size()) &&
-          (static_cast<size_t>(mLabelParams.mRowNameIdx) < mData.at(dataRowIdx).size()))
-      {
-        const std::string oldName = mData.at(dataRowIdx).at(static_cast<size_t>(mLabelParams.mRowNameIdx));
-        mRowNames.erase(oldName);
-      }
-      mRowNames[pRowName] = dataRowIdx;
-      if (mLabelParams.mRowNameIdx < 0)
+      const int columnIdx = GetColumnIdx(pColumnName);
+      if (columnIdx < 0)
       {
-        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
+        throw std::out_of_range("column not found: " + pColumnName);
       }
 
-      // increase table size if necessary:
-      if (dataRowIdx >= mData.size())
+      return GetCell<T>(static_cast<size_t>(columnIdx), pRowIdx);
+    }
+
+    /**
+     * @brief   Get row by index.
+     * @param   pRowIdx               zero-based row index.
+     * @returns vector of row data, excluding the row label.
+     */
+    template<typename T>
+    std::vector<T> GetRow(const size_t pRowIdx) const
+    {
+      std::vector<T> row;
+      GetRow<T>(pRowIdx, row);
+      return row;
+    }
+
+    /**
+     * @brief   Get row by index into a caller-provided vector, reusing its capacity.
+     * @param   pRowIdx               zero-based row index.
+     * @param   pRow                  vector replaced with the row data, excluding the row label.
+     */
+    template<typename T>
+    void GetRow(const size_t pRowIdx, std::vector<T>& pRow) const
+    {
+      const std::vector<std::string>& row = GetDataRow(pRowIdx);
+      pRow.clear();
+      if (row.size() > GetDataColumnIndex(0))
       {
-        mData.resize(dataRowIdx + 1);
+        pRow.reserve(row.size() - GetDataColumnIndex(0));
       }
 
-      std::vector<std::string>& row = mData[dataRowIdx];
-      if (mLabelParams.mRowNameIdx >= static_cast<std::ptrdiff_t>(row.size()))
+      Converter<T> converter(mConverterParams);
+      for (size_t dataColumnIdx = GetDataColumnIndex(0); dataColumnIdx < row.size(); ++dataColumnIdx)
       {
-        row.resize(static_cast<size_t>(mLabelParams.mRowNameIdx) + 1);
+        T val;
+        converter.ToVal(row.at(dataColumnIdx), val);
+        pRow.push_back(val);
       }
-
-      mData.at(dataRowIdx).at(static_cast<size_t>(mLabelParams.mRowNameIdx)) = pRowName;
     }
 
     /**
-     * @brief   Get row names
-     * @returns vector of row names.
+     * @brief   Get row name
+     * @param   pRowIdx               zero-based row index.
+     * @returns row name.
      */
-    std::vector<std::string> GetRowNames() const
+    std::string GetRowName(const size_t pRowIdx) const
     {
-      std::vector<std::string> rownames;
-      if (mLabelParams.mRowNameIdx >= 0)
+      if (mLabelParams.mRowNameIdx < 0)
       {
-        for (auto itRow = mData.begin(); itRow != mData.end(); ++itRow)
-        {
-          if (std::distance(mData.begin(), itRow) > mLabelParams.mColumnNameIdx)
-          {
-            rownames.push_back(itRow->at(static_cast<size_t>(mLabelParams.mRowNameIdx)));
-          }
-        }
+        throw std::out_of_range("row name column index < 0: " + std::to_string(mLabelParams.mRowNameIdx));
       }
-      return rownames;
+
+      return GetDataRow(pRowIdx).at(static_cast<size_t>(mLabelParams.mRowNameIdx));
     }
 
-  private:
-    void ReadCsv()
+    /**
+     * @brief   Get number of blocks of rows read and parsed from the CSV-file, i.e. row accesses not
+     *          served by the block cache.
+     * @returns block read count.
+     */
+    size_t GetBlockReadCount() const
     {
-      std::ifstream stream;
-      stream.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-      stream.open(mPath, std::ios::binary);
-      ReadCsv(stream);
+      return mBlockReadCount;
     }
 
-    void ReadCsv(std::istream& pStream)
+  private:
+    // parsed rows of the rows indexed by one row offset
+    struct CachedBlock
     {
-      Clear();
-      pStream.seekg(0, std::ios::end);
-      std::streamsize length = pStream.tellg();
-      pStream.seekg(0, std::ios::beg);
+      size_t mBlockIdx;
+      size_t mLastUse;
+      std::vector<std::vector<std::string>> mRows;
+    };
 
-      std::vector<char> bom2b(2, '\0');
-      if (length >= 2)
+    void ReadColumnNames()
+    {
+      const size_t headerRowIdx = static_cast<size_t>(std::max(mLabelParams.mColumnNameIdx, 0));
+      if (headerRowIdx >= mRowCount)
       {
-        pStream.read(bom2b.data(), 2);
-        pStream.seekg(0, std::ios::beg);
+        return;
       }
 
-      static const std::vector<char> bomU16le = { '\xff', '\xfe' };
-      static const std::vector<char> bomU16be = { '\xfe', '\xff' };
-      if ((bom2b == bomU16le) || (bom2b == bomU16be))
-      {
-        mIsUtf16 = true;
-        mIsLE = (bom2b == bomU16le);
-
-        std::vector<char> buffer(static_cast<size_t>(length));
-        pStream.read(buffer.data(), length);
-
-        // skip byte order mark
-        const std::string utf8 = Utf16ToUtf8(buffer.data() + 2, static_cast<size_t>(length) - 2,
-                                             mIsLE);
-        std::stringstream ss(utf8);
-        ParseCsv(ss, static_cast<std::streamsize>(utf8.size()));
-      }
-      else
+      const std::vector<std::string>& headerRow = GetParsedRow(headerRowIdx);
+      mColumnCount = (headerRow.size() > GetDataColumnIndex(0)) ? (headerRow.size() - GetDataColumnIndex(0)) : 0;
+      if (mLabelParams.mColumnNameIdx >= 0)
       {
-        // check for UTF-8 Byte order mark and skip it when found
-        if (length >= 3)
+        mColumnNameRow = headerRow;
+        mColumnNames.Reserve(mColumnNameRow.size());
+        for (size_t i = 0; i < mColumnNameRow.size(); ++i)
         {
-          std::vector<char> bom3b(3, '\0');
-          pStream.read(bom3b.data(), 3);
-
-          if (bom3b != s_Utf8BOM)
-          {
-            // file does not start with a UTF-8 Byte order mark
-            pStream.seekg(0, std::ios::beg);
-          }
-          else
-          {
-            // file did start with a UTF-8 Byte order mark, simply skip it
-            length -= 3;
-            mHasUtf8BOM = true;
-          }
+          mColumnNames.Set(mColumnNameRow.at(i), i);
         }
-
-        ParseCsv(pStream, length);
       }
     }
 
-    static inline void CheckMaxCount(const size_t pCount)
+    // rows preceding and including the column label row are not accessible, like for Document
+    inline size_t GetFirstRowIndex() const
     {
-#ifdef RAPIDCSV_MAX_COUNT
-      static_assert(RAPIDCSV_MAX_COUNT > 0, "RAPIDCSV_MAX_COUNT must be a positive value");
-      static const size_t s_MaxCount = static_cast<size_t>(RAPIDCSV_MAX_COUNT);
-      if (pCount > s_MaxCount)
+      return static_cast<size_t>(std::max(mLabelParams.mColumnNameIdx + 1, 0));
+    }
+
+    inline size_t GetDataColumnIndex(const size_t pColumnIdx) const
+    {
+      return mParser.GetDataColumnIndex(pColumnIdx);
+    }
+
+    const std::vector<std::string>& GetDataRow(const size_t pRowIdx) const
+    {
+      if (pRowIdx >= GetRowCount())
       {
-        const std::string errStr = "max count exceeded: " + std::to_string(s_MaxCount);
+        const std::string errStr = "row out of range: " + std::to_string(pRowIdx);
         throw std::out_of_range(errStr);
       }
-#else
-      (void)pCount;
-#endif
+
+      return GetParsedRow(GetFirstRowIndex() + pRowIdx);
     }
 
-    void ParseCsv(std::istream& pStream, std::streamsize p_FileLength)
+    // Returns a row of the file, counting all rows that are not skipped, parsing its block unless
+    // cached. The returned reference is valid until the next call.
+    const std::vector<std::string>& GetParsedRow(const size_t pRowIdx) const
     {
-      const std::streamsize bufLength = 64 * 1024;
-      std::vector<char> buffer(bufLength);
-      std::vector<std::string> row;
-      std::string cell;
-      bool quoted = false;
-      int cr = 0;
-      int lf = 0;
-
-      while (p_FileLength > 0)
+      const size_t blockIdx = pRowIdx / mIndexParams.mRowStride;
+      CachedBlock* block = nullptr;
+      for (CachedBlock& cachedBlock : mBlocks)
       {
-        const std::streamsize toReadLength = std::min<std::streamsize>(p_FileLength, bufLength);
-        pStream.read(buffer.data(), toReadLength);
-
-        // With user-specified istream opened in non-binary mode on windows, we may have a
-        // data length mismatch, so ensure we don't parse outside actual data length read.
-        const std::streamsize readLength = pStream.gcount();
-        if (readLength <= 0)
+        if (cachedBlock.mBlockIdx == blockIdx)
         {
+          block = &cachedBlock;
           break;
         }
-
-        for (size_t i = 0; i < static_cast<size_t>(readLength); ++i)
-        {
-          if (buffer[i] == mSeparatorParams.mQuoteChar)
-          {
-            if (cell.empty() || (cell[0] == mSeparatorParams.mQuoteChar))
-            {
-              quoted = !quoted;
-            }
-            else if (mSeparatorParams.mTrim)
-            {
-              // allow whitespace before first mQuoteChar
-              const auto firstQuote = std::find(cell.begin(), cell.end(), mSeparatorParams.mQuoteChar);
-              if (std::all_of(cell.begin(), firstQuote, [](unsigned char ch) { return isspace(ch); }))
-              {
-                quoted = !quoted;
-              }
-            }
-            cell += buffer[i];
-          }
-          else if (buffer[i] == mSeparatorParams.mSeparator)
-          {
-            if (!quoted)
-            {
-              CheckMaxCount(row.size() + 1);
-              row.push_back(Unquote(Trim(cell)));
-              cell.clear();
-            }
-            else
-            {
-              cell += buffer[i];
-            }
-          }
-          else if (buffer[i] == '\r')
-          {
-            if (mSeparatorParams.mQuotedLinebreaks && quoted)
-            {
-              cell += buffer[i];
-            }
-            else
-            {
-              ++cr;
-            }
-          }
-          else if (buffer[i] == '\n')
-          {
-            if (mSeparatorParams.mQuotedLinebreaks && quoted)
-            {
-              cell += buffer[i];
-            }
-            else
-            {
-              ++lf;
-              if (mLineReaderParams.mSkipEmptyLines && row.empty() && cell.empty())
-              {
-                // skip empty line
-              }
-              else
-              {
-                CheckMaxCount(row.size() + 1);
-                row.push_back(Unquote(Trim(cell)));
-
-                if (mLineReaderParams.mSkipCommentLines && !row.at(0).empty() &&
-                    (row.at(0)[0] == mLineReaderParams.mCommentPrefix))
-                {
-                  // skip comment line
-                }
-                else
-                {
-                  CheckMaxCount(mData.size() + 1);
-                  mData.push_back(row);
-                }
-
-                cell.clear();
-                row.clear();
-                quoted = false;
-              }
-            }
-          }
-          else
-          {
-            cell += buffer[i];
-          }
-        }
-        p_FileLength -= readLength;
       }
 
-      // Handle last row / cell without linebreak
-      if (row.empty() && cell.empty())
-      {
-        // skip empty trailing line
-      }
-      else
+      if (block == nullptr)
       {
-        CheckMaxCount(row.size() + 1);
-        row.push_back(Unquote(Trim(cell)));
-
-        if (mLineReaderParams.mSkipCommentLines && !row.at(0).empty() &&
-            (row.at(0)[0] == mLineReaderParams.mCommentPrefix))
+        if (mBlocks.size() < mIndexParams.mCacheBlockCount)
         {
-          // skip comment line
+          mBlocks.push_back(CachedBlock{ blockIdx, 0, std::vector<std::vector<std::string>>() });
+          block = &mBlocks.back();
         }
         else
         {
-          CheckMaxCount(mData.size() + 1);
-          mData.push_back(row);
-        }
-
-        cell.clear();
-        row.clear();
-        quoted = false;
-      }
-
-      // Assume CR/LF if at least half the linebreaks have CR
-      mSeparatorParams.mHasCR = (cr > (lf / 2));
-
-      // Set up column labels
-      UpdateColumnNames();
-
-      // Set up row labels
-      UpdateRowNames();
-    }
-
-    void WriteCsv() const
-    {
-      if (mIsUtf16)
-      {
-        std::stringstream ss;
-        WriteCsv(ss);
-        const std::string utf16 = Utf8ToUtf16(ss.str(), mIsLE);
-
-        std::ofstream stream;
-        stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        stream.open(mPath, std::ios::binary | std::ios::trunc);
-        stream.write(utf16.data(), static_cast<std::streamsize>(utf16.size()));
-      }
-      else
-      {
-        std::ofstream stream;
-        stream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-        stream.open(mPath, std::ios::binary | std::ios::trunc);
-        if (mHasUtf8BOM)
-        {
-          stream.write(s_Utf8BOM.data(), 3);
+          block = &*std::min_element(mBlocks.begin(), mBlocks.end(),
+                                     [](const CachedBlock& pLhs, const CachedBlock& pRhs)
+                                     { return pLhs.mLastUse < pRhs.mLastUse; });
         }
 
-        WriteCsv(stream);
+        block->mBlockIdx = blockIdx;
+        ReadBlock(blockIdx, block->mRows);
+        ++mBlockReadCount;
       }
+
+      block->mLastUse = ++mBlockUseCount;
+      return block->mRows.at(pRowIdx - (blockIdx * mIndexParams.mRowStride));
+    }
+
+    void ReadBlock(const size_t pBlockIdx, std::vector<std::vector<std::string>>& pRows) const
+    {
+      const uint64_t begin = mRowOffsets.at(pBlockIdx);
+      const uint64_t end = ((pBlockIdx + 1) < mRowOffsets.size()) ? mRowOffsets[pBlockIdx + 1] : mFileSize;
+      std::vector<char> data(static_cast<size_t>(end - begin));
+      mFile.clear();
+      mFile.seekg(static_cast<std::streamoff>(begin));
+      mFile.read(data.data(), static_cast<std::streamsize>(data.size()));
+      const size_t length = static_cast<size_t>(std::max<std::streamsize>(mFile.gcount(), 0));
+
+      // blocks start at a row boundary, i.e. outside of any quoted cell
+      Document::ParseState state(mParser.mSeparatorParams);
+      state.mDeferRows = true;
+      state.mRows.swap(pRows);
+      state.mRows.clear();
+      mParser.ParseBuffer(data.data(), data.data() + length, state);
+      mParser.ParseLastRow(state);
+      pRows.swap(state.mRows);
     }
 
-    void WriteCsv(std::ostream& pStream) const
+    void BuildIndex()
     {
-      for (auto itr = mData.begin(); itr != mData.end(); ++itr)
+      Document::ParseState state(mParser.mSeparatorParams);
+      state.mDeferRows = true;
+      state.mRecordRowEnds = true;
+      std::vector<char> buffer(s_BufferLength);
+      uint64_t offset = 0;
+      bool isFirstChunk = true;
+      mRowCount = 0;
+      mRowOffsets.clear();
+      mFile.clear();
+      mFile.seekg(0);
+      while (true)
       {
-        for (auto itc = itr->begin(); itc != itr->end(); ++itc)
+        mFile.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const size_t length = static_cast<size_t>(std::max<std::streamsize>(mFile.gcount(), 0));
+        const char* data = buffer.data();
+        const char* dataEnd = data + length;
+        if (isFirstChunk)
         {
-          if (mSeparatorParams.mAutoQuote &&
-              ((itc->find(mSeparatorParams.mSeparator) != std::string::npos) ||
-               (itc->find(mSeparatorParams.mQuoteChar) != std::string::npos) ||
-               (itc->find(' ') != std::string::npos) ||
-               (itc->find('\n') != std::string::npos) ||
-               (itc->find('\r') != std::string::npos)))
+          isFirstChunk = false;
+          if (Document::IsUtf16BOM(data, length))
           {
-            // escape quotes in string
-            std::string str = *itc;
-            const std::string quoteCharStr = std::string(1, mSeparatorParams.mQuoteChar);
-            ReplaceString(str, quoteCharStr, quoteCharStr + quoteCharStr);
-
-            pStream << quoteCharStr << str << quoteCharStr;
+            throw std::invalid_argument("indexed reader does not support utf-16");
           }
-          else
+          else if ((length >= 3) && std::equal(s_Utf8BOM.begin(), s_Utf8BOM.end(), data))
           {
-            pStream << *itc;
+            data += 3;
           }
 
-          if (std::distance(itc, itr->end()) > 1)
+          mRowOffsets.push_back(static_cast<uint64_t>(data - buffer.data()));
+        }
+
+        if (length == 0)
+        {
+          break;
+        }
+
+        mParser.ParseBuffer(data, dataEnd, state);
+        for (const char* rowEnd : state.mRowEnds)
+        {
+          if ((++mRowCount % mIndexParams.mRowStride) == 0)
           {
-            pStream << mSeparatorParams.mSeparator;
+            mRowOffsets.push_back(offset + static_cast<uint64_t>(rowEnd - buffer.data()));
           }
         }
-        pStream << (mSeparatorParams.mHasCR ? "\r\n" : "\n");
+
+        state.mRowEnds.clear();
+        state.mRows.clear();
+        offset += length;
       }
-    }
 
-    size_t GetDataRowCount() const
-    {
-      return mData.size();
-    }
+      mParser.ParseLastRow(state);
+      mRowCount += state.mRows.size();
 
-    size_t GetDataColumnCount() const
-    {
-      const size_t firstDataRow =
-        static_cast<size_t>((mLabelParams.mColumnNameIdx >= 0) ? mLabelParams.mColumnNameIdx : 0);
-      return (mData.size() > firstDataRow) ? mData.at(firstDataRow).size() : 0;
+      // drop the offset of the end of the file following a complete last block
+      mRowOffsets.resize(GetBlockCount(mRowCount));
     }
 
-    inline size_t GetDataRowIndex(const size_t pRowIdx) const
+    inline size_t GetBlockCount(const uint64_t pRowCount) const
     {
-      const size_t firstDataRow =
-        static_cast<size_t>((mLabelParams.mColumnNameIdx + 1 >= 0) ? mLabelParams.mColumnNameIdx + 1 : 0);
-      return pRowIdx + firstDataRow;
+      const uint64_t blockCount = (pRowCount + mIndexParams.mRowStride - 1) / mIndexParams.mRowStride;
+      return std::max<size_t>(static_cast<size_t>(blockCount), 1);
     }
 
-    inline size_t GetDataColumnIndex(const size_t pColumnIdx) const
+    // Identifies the parameters affecting which rows are found, for validating the index file.
+    uint64_t GetIndexKey() const
     {
-      const size_t firstDataColumn =
-        static_cast<size_t>((mLabelParams.mRowNameIdx + 1 >= 0) ? mLabelParams.mRowNameIdx + 1 : 0);
-      return pColumnIdx + firstDataColumn;
+      const SeparatorParams& separatorParams = mParser.mSeparatorParams;
+      const LineReaderParams& lineReaderParams = mParser.mLineReaderParams;
+      return static_cast<uint64_t>(static_cast<unsigned char>(separatorParams.mSeparator)) |
+             (static_cast<uint64_t>(static_cast<unsigned char>(separatorParams.mQuoteChar)) << 8) |
+             (static_cast<uint64_t>(static_cast<unsigned char>(lineReaderParams.mCommentPrefix)) << 16) |
+             (static_cast<uint64_t>(separatorParams.mTrim) << 24) |
+             (static_cast<uint64_t>(separatorParams.mQuotedLinebreaks) << 25) |
+             (static_cast<uint64_t>(lineReaderParams.mSkipCommentLines) << 26) |
+             (static_cast<uint64_t>(lineReaderParams.mSkipEmptyLines) << 27);
     }
 
-    std::string Trim(const std::string& pStr) const
+    // The index file holds a header of native endian 64-bit values, followed by the row offsets.
+    void SaveIndex() const
     {
-      if (mSeparatorParams.mTrim)
-      {
-        std::string str = pStr;
-
-        // ltrim
-        str.erase(str.begin(), std::find_if(str.begin(), str.end(), [](unsigned char ch) { return !isspace(ch); }));
-
-        // rtrim
-        str.erase(std::find_if(str.rbegin(), str.rend(), [](unsigned char ch) {
-          return !isspace(ch);
-        }).base(), str.end());
-
-        return str;
-      }
-      else
+      std::ofstream stream(mIndexParams.mIndexPath, std::ios::binary | std::ios::trunc);
+      stream.write(s_IndexMagic.data(), static_cast<std::streamsize>(s_IndexMagic.size()));
+      const uint64_t header[] = { mFileSize, mFileTime, mFileChecksum, mIndexParams.mRowStride, GetIndexKey(),
+                                  mRowCount, mRowOffsets.size() };
+      stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+      stream.write(reinterpret_cast<const char*>(mRowOffsets.data()),
+                   static_cast<std::streamsize>(mRowOffsets.size() * sizeof(uint64_t)));
+      stream.close();
+      if (!stream)
       {
-        return pStr;
+        // an index that cannot be saved is only used in memory
+        std::remove(mIndexParams.mIndexPath.c_str());
       }
     }
 
-    std::string Unquote(const std::string& pStr) const
+    bool LoadIndex()
     {
-      if (mSeparatorParams.mAutoQuote && (pStr.size() >= 2) &&
-          (pStr.front() == mSeparatorParams.mQuoteChar) &&
-          (pStr.back() == mSeparatorParams.mQuoteChar))
+      std::ifstream stream(mIndexParams.mIndexPath, std::ios::binary);
+      std::vector<char> magic(s_IndexMagic.size());
+      uint64_t header[7] = { 0 };
+      stream.read(magic.data(), static_cast<std::streamsize>(magic.size()));
+      stream.read(reinterpret_cast<char*>(header), sizeof(header));
+      if (!stream || (magic != s_IndexMagic) ||
+          (header[0] != mFileSize) || (header[1] != mFileTime) || (header[2] != mFileChecksum) ||
+          (header[3] != mIndexParams.mRowStride) || (header[4] != GetIndexKey()) ||
+          (header[6] != GetBlockCount(header[5])))
       {
-        // remove start/end quotes
-        std::string str = pStr.substr(1, pStr.size() - 2);
-
-        // unescape quotes in string
-        const std::string quoteCharStr = std::string(1, mSeparatorParams.mQuoteChar);
-        ReplaceString(str, quoteCharStr + quoteCharStr, quoteCharStr);
-
-        return str;
+        return false;
       }
-      else
+
+      std::vector<uint64_t> rowOffsets(static_cast<size_t>(header[6]));
+      stream.read(reinterpret_cast<char*>(rowOffsets.data()),
+                  static_cast<std::streamsize>(rowOffsets.size() * sizeof(uint64_t)));
+      if (!stream || !std::is_sorted(rowOffsets.begin(), rowOffsets.end()) || (rowOffsets.back() > mFileSize))
       {
-        return pStr;
+        return false;
       }
+
+      mRowCount = header[5];
+      mRowOffsets.swap(rowOffsets);
+      return true;
     }
 
-    void UpdateColumnNames()
+    // Returns the modification time in nanoseconds, or zero where unavailable.
+    static uint64_t GetFileTime(const std::string& pPath)
     {
-      mColumnNames.clear();
-      if ((mLabelParams.mColumnNameIdx >= 0) &&
-          (static_cast<std::ptrdiff_t>(mData.size()) > mLabelParams.mColumnNameIdx))
+#if defined(RAPIDCSV_HAS_MMAP)
+      struct stat fileStat;
+      if (stat(pPath.c_str(), &fileStat) == 0)
       {
-        size_t i = 0;
-        for (auto& columnName : mData[static_cast<size_t>(mLabelParams.mColumnNameIdx)])
-        {
-          mColumnNames[columnName] = i++;
-        }
+#if defined(__APPLE__)
+        const struct timespec& fileTime = fileStat.st_mtimespec;
+#else
+        const struct timespec& fileTime = fileStat.st_mtim;
+#endif
+        return (static_cast<uint64_t>(fileTime.tv_sec) * 1000000000ULL) + static_cast<uint64_t>(fileTime.tv_nsec);
       }
+#else
+      (void)pPath;
+#endif
+      return 0;
     }
 
-    void UpdateRowNames()
+    // FNV-1a of the first and last bytes of the CSV-file, detecting modifications keeping its
+    // size within the resolution of the modification time, or where it is unavailable.
+    uint64_t GetFileChecksum() const
     {
-      mRowNames.clear();
-      if ((mLabelParams.mRowNameIdx >= 0) &&
-          (static_cast<std::ptrdiff_t>(mData.size()) >
-           (mLabelParams.mColumnNameIdx + 1)))
+      const uint64_t length = std::min(mFileSize, static_cast<uint64_t>(s_ChecksumLength));
+      std::vector<char> buffer(static_cast<size_t>(length * 2));
+      mFile.clear();
+      mFile.seekg(0);
+      mFile.read(buffer.data(), static_cast<std::streamsize>(length));
+      mFile.clear();
+      mFile.seekg(static_cast<std::streamoff>(mFileSize - length));
+      mFile.read(buffer.data() + length, static_cast<std::streamsize>(length));
+      mFile.clear();
+
+      uint64_t hash = 14695981039346656037ULL;
+      for (const char byte : buffer)
       {
-        size_t i = 0;
-        for (auto& dataRow : mData)
-        {
-          // rows too short to hold a row label are left unnamed, but must still be counted
-          if (static_cast<std::ptrdiff_t>(dataRow.size()) > mLabelParams.mRowNameIdx)
-          {
-            mRowNames[dataRow[static_cast<size_t>(mLabelParams.mRowNameIdx)]] = i;
-          }
-          ++i;
-        }
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= 1099511628211ULL;
       }
+
+      return hash;
     }
 
-    // Unicode code point used in place of malformed input.
-    static const uint32_t s_ReplacementChar = 0x0000fffd;
+  private:
+    static const size_t s_BufferLength = 64 * 1024;
+    static const size_t s_ChecksumLength = 4 * 1024;
 
-    // Reads the UTF-16 code unit at byte offset pIdx, which must be a valid offset
-    // of a complete code unit.
-    static uint32_t GetUtf16Unit(const char* pData, size_t pIdx, bool pIsLE)
+    mutable Document mParser;
+    LabelParams mLabelParams;
+    ConverterParams mConverterParams;
+    IndexParams mIndexParams;
+    mutable std::ifstream mFile;
+    uint64_t mFileSize;
+    uint64_t mFileTime;
+    uint64_t mFileChecksum;
+    uint64_t mRowCount;
+    std::vector<uint64_t> mRowOffsets;
+    bool mIsIndexLoaded;
+    size_t mColumnCount;
+    std::vector<std::string> mColumnNameRow;
+    LabelIndex mColumnNames;
+    mutable std::vector<CachedBlock> mBlocks;
+    mutable size_t mBlockUseCount;
+    mutable size_t mBlockReadCount;
+  };
+
+  /**
+   * @brief     Class representing a forward-only writer of CSV rows. Rows are formatted into an
+   *            internal buffer, which is transcoded if needed and written to the output once full,
+   *            so memory usage is bounded by the buffer size rather than by the size of the output.
+   */
+  class Writer
+  {
+  public:
+    /**
+     * @brief   Constructor
+     * @param   pPath                 specifies the path of the CSV-file to create.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how numbers should be converted to strings.
+     * @param   pWriterParams         specifies how the CSV data should be encoded and buffered.
+     */
+    explicit Writer(const std::string& pPath,
+                    const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                    const ConverterParams& pConverterParams = ConverterParams(),
+                    const WriterParams& pWriterParams = WriterParams())
+      : mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mWriterParams(pWriterParams)
+      , mFile()
+      , mStream(mFile)
+      , mBuffer()
+      , mUtf16()
+      , mCell()
+      , mCellCount(0)
+      , mQuoteTable(pSeparatorParams)
     {
-      const uint32_t byte0 = static_cast<unsigned char>(pData[pIdx]);
-      const uint32_t byte1 = static_cast<unsigned char>(pData[pIdx + 1]);
-      return pIsLE ? ((byte1 << 8) | byte0) : ((byte0 << 8) | byte1);
+      mFile.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+      mFile.open(pPath, std::ios::binary | std::ios::trunc);
+      Document::WriteBOM(mStream, mWriterParams.mUtf16, mWriterParams.mLittleEndian, mWriterParams.mUtf8BOM);
     }
 
-    static void AppendUtf16Unit(uint32_t pUnit, bool pIsLE, std::string& pUtf16)
+    /**
+     * @brief   Constructor
+     * @param   pStream               specifies a binary output stream to write CSV data to.
+     * @param   pSeparatorParams      specifies which field and row separators should be used.
+     * @param   pConverterParams      specifies how numbers should be converted to strings.
+     * @param   pWriterParams         specifies how the CSV data should be encoded and buffered.
+     */
+    explicit Writer(std::ostream& pStream,
+                    const SeparatorParams& pSeparatorParams = SeparatorParams(),
+                    const ConverterParams& pConverterParams = ConverterParams(),
+                    const WriterParams& pWriterParams = WriterParams())
+      : mSeparatorParams(pSeparatorParams)
+      , mConverterParams(pConverterParams)
+      , mWriterParams(pWriterParams)
+      , mFile()
+      , mStream(pStream)
+      , mBuffer()
+      , mUtf16()
+      , mCell()
+      , mCellCount(0)
+      , mQuoteTable(pSeparatorParams)
     {
-      const char lowByte = static_cast<char>(pUnit & 0xff);
-      const char highByte = static_cast<char>((pUnit >> 8) & 0xff);
-      pUtf16 += pIsLE ? lowByte : highByte;
-      pUtf16 += pIsLE ? highByte : lowByte;
+      Document::WriteBOM(mStream, mWriterParams.mUtf16, mWriterParams.mLittleEndian, mWriterParams.mUtf8BOM);
     }
 
-    static void AppendUtf16(uint32_t pCodePoint, bool pIsLE, std::string& pUtf16)
+    /**
+     * @brief   Destructor, writing any buffered data. Errors are not reported, hence Flush()
+     *          should be called before destruction to detect them.
+     */
+    ~Writer()
     {
-      if (pCodePoint >= 0x10000)
+      try
       {
-        // encode as surrogate pair
-        const uint32_t offset = pCodePoint - 0x10000;
-        AppendUtf16Unit(0xd800 + (offset >> 10), pIsLE, pUtf16);
-        AppendUtf16Unit(0xdc00 + (offset & 0x3ff), pIsLE, pUtf16);
+        Flush();
       }
-      else
+      catch (...)
       {
-        AppendUtf16Unit(pCodePoint, pIsLE, pUtf16);
       }
     }
 
-    static void AppendUtf8(uint32_t pCodePoint, std::string& pUtf8)
+    /**
+     * @brief   Write a cell to the current row.
+     * @param   pCell                 cell data.
+     */
+    template<typename T>
+    void WriteCell(const T& pCell)
     {
-      if (pCodePoint < 0x80)
-      {
-        pUtf8 += static_cast<char>(pCodePoint);
-      }
-      else if (pCodePoint < 0x800)
-      {
-        pUtf8 += static_cast<char>(0xc0 | (pCodePoint >> 6));
-        pUtf8 += static_cast<char>(0x80 | (pCodePoint & 0x3f));
-      }
-      else if (pCodePoint < 0x10000)
-      {
-        pUtf8 += static_cast<char>(0xe0 | (pCodePoint >> 12));
-        pUtf8 += static_cast<char>(0x80 | ((pCodePoint >> 6) & 0x3f));
-        pUtf8 += static_cast<char>(0x80 | (pCodePoint & 0x3f));
-      }
-      else
+      if (mCellCount > 0)
       {
-        pUtf8 += static_cast<char>(0xf0 | (pCodePoint >> 18));
-        pUtf8 += static_cast<char>(0x80 | ((pCodePoint >> 12) & 0x3f));
-        pUtf8 += static_cast<char>(0x80 | ((pCodePoint >> 6) & 0x3f));
-        pUtf8 += static_cast<char>(0x80 | (pCodePoint & 0x3f));
+        mBuffer += mSeparatorParams.mSeparator;
       }
+
+      Converter<T> converter(mConverterParams);
+      converter.ToStr(pCell, mCell);
+      Document::AppendCell(mCell, mSeparatorParams, mQuoteTable, mBuffer);
+      ++mCellCount;
     }
 
-    // Converts UTF-16 encoded data (without byte order mark) to UTF-8. Surrogate pairs
-    // are combined into a single code point. Unpaired surrogates and a trailing odd byte
-    // are replaced with U+FFFD.
-    static std::string Utf16ToUtf8(const char* pData, size_t pSize, bool pIsLE)
+    /**
+     * @brief   End the current row, writing the buffered data to the output if the buffer is full.
+     */
+    void EndRow()
     {
-      std::string utf8;
-      utf8.reserve(pSize);
-
-      size_t idx = 0;
-      while ((idx + 1) < pSize)
-      {
-        uint32_t codePoint = GetUtf16Unit(pData, idx, pIsLE);
-        idx += 2;
-
-        if ((codePoint >= 0xd800) && (codePoint <= 0xdbff) && ((idx + 1) < pSize))
-        {
-          // high surrogate - combine with low surrogate, when present
-          const uint32_t lowSurrogate = GetUtf16Unit(pData, idx, pIsLE);
-          if ((lowSurrogate >= 0xdc00) && (lowSurrogate <= 0xdfff))
-          {
-            codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (lowSurrogate - 0xdc00);
-            idx += 2;
-          }
-        }
-
-        if ((codePoint >= 0xd800) && (codePoint <= 0xdfff))
-        {
-          // unpaired surrogate
-          codePoint = s_ReplacementChar;
-        }
-
-        AppendUtf8(codePoint, utf8);
-      }
-
-      if (idx < pSize)
+      mBuffer += (mSeparatorParams.mHasCR ? "\r\n" : "\n");
+      mCellCount = 0;
+      if (mBuffer.size() >= mWriterParams.mBufferSize)
       {
-        // trailing odd byte
-        AppendUtf8(s_ReplacementChar, utf8);
+        Document::WriteBuffer(mStream, mWriterParams.mUtf16, mWriterParams.mLittleEndian, mBuffer, mUtf16);
       }
-
-      return utf8;
     }
 
-    // Converts UTF-8 encoded data to UTF-16, prefixed with a byte order mark. Code points
-    // outside the basic multilingual plane are encoded as surrogate pairs. Malformed input
-    // is replaced with U+FFFD.
-    static std::string Utf8ToUtf16(const std::string& pUtf8, bool pIsLE)
+    /**
+     * @brief   Write a row.
+     * @param   pRow                  vector of row data.
+     */
+    template<typename T>
+    void WriteRow(const std::vector<T>& pRow)
     {
-      std::string utf16;
-      utf16.reserve((pUtf8.size() + 1) * 2);
-
-      AppendUtf16(0x0000feff, pIsLE, utf16);
-
-      size_t idx = 0;
-      while (idx < pUtf8.size())
+      for (const T& cell : pRow)
       {
-        const uint32_t leadByte = static_cast<unsigned char>(pUtf8[idx]);
-        uint32_t codePoint = 0;
-        size_t seqLen = 0;
-
-        if (leadByte < 0x80)
-        {
-          codePoint = leadByte;
-          seqLen = 1;
-        }
-        else if ((leadByte & 0xe0) == 0xc0)
-        {
-          codePoint = leadByte & 0x1f;
-          seqLen = 2;
-        }
-        else if ((leadByte & 0xf0) == 0xe0)
-        {
-          codePoint = leadByte & 0x0f;
-          seqLen = 3;
-        }
-        else if ((leadByte & 0xf8) == 0xf0)
-        {
-          codePoint = leadByte & 0x07;
-          seqLen = 4;
-        }
-        else
-        {
-          // invalid lead byte
-          codePoint = s_ReplacementChar;
-          seqLen = 1;
-        }
-
-        if ((seqLen > 1) && ((idx + seqLen) <= pUtf8.size()))
-        {
-          for (size_t byteIdx = 1; byteIdx < seqLen; ++byteIdx)
-          {
-            const uint32_t contByte = static_cast<unsigned char>(pUtf8[idx + byteIdx]);
-            if ((contByte & 0xc0) != 0x80)
-            {
-              // invalid continuation byte
-              codePoint = s_ReplacementChar;
-              seqLen = 1;
-              break;
-            }
-
-            codePoint = (codePoint << 6) | (contByte & 0x3f);
-          }
-        }
-        else if (seqLen > 1)
-        {
-          // truncated sequence
-          codePoint = s_ReplacementChar;
-          seqLen = 1;
-        }
-
-        // reject out of range code points, surrogates and overlong sequences
-        static const uint32_t minCodePoint[5] = { 0, 0, 0x80, 0x800, 0x10000 };
-        if ((codePoint > 0x0010ffff) ||
-            ((codePoint >= 0xd800) && (codePoint <= 0xdfff)) ||
-            (codePoint < minCodePoint[seqLen]))
-        {
-          codePoint = s_ReplacementChar;
-        }
-
-        AppendUtf16(codePoint, pIsLE, utf16);
-        idx += seqLen;
+        WriteCell(cell);
       }
-
-      return utf16;
+      EndRow();
     }
 
-    static void ReplaceString(std::string& pStr, const std::string& pSearch, const std::string& pReplace)
+    /**
+     * @brief   Write buffered data to the output and flush it.
+     */
+    void Flush()
     {
-      size_t pos = 0;
-
-      while ((pos = pStr.find(pSearch, pos)) != std::string::npos)
-      {
-        pStr.replace(pos, pSearch.size(), pReplace);
-        pos += pReplace.size();
-      }
+      Document::WriteBuffer(mStream, mWriterParams.mUtf16, mWriterParams.mLittleEndian, mBuffer, mUtf16);
+      mStream.flush();
     }
 
   private:
-    std::string mPath;
-    LabelParams mLabelParams;
     SeparatorParams mSeparatorParams;
     ConverterParams mConverterParams;
-    LineReaderParams mLineReaderParams;
-    std::vector<std::vector<std::string>> mData;
-    std::map<std::string, size_t> mColumnNames;
-    std::map<std::string, size_t> mRowNames;
-    bool mIsUtf16 = false;
-    bool mIsLE = false;
-    bool mHasUtf8BOM = false;
+    WriterParams mWriterParams;
+    std::ofstream mFile;
+    std::ostream& mStream;
+    std::string mBuffer;
+    std::string mUtf16;
+    std::string mCell;
+    size_t mCellCount;
+    Document::QuoteTable mQuoteTable;
   };
 }
@@ -70,6 +70,18 @@ namespace perftest
       std::cout << static_cast<long long>(round(GetMedianDurationUs())) << " us\n";
     }
 
+    void ReportMedianPerItem(const double items)
+    {
+      std::cout << "Test median duration per item                  Elapsed   ";
+      std::cout << std::fixed << std::setprecision(1) << (GetMedianDurationSec() * 1e9 / items) << " ns\n";
+    }
+
+    void ReportMedianThroughput(const double bytes)
+    {
+      std::cout << "Test median throughput                         Rate      ";
+      std::cout << std::fixed << std::setprecision(3) << (bytes / GetMedianDurationSec() / 1e9) << " GB/s\n";
+    }
+
   private:
     std::chrono::high_resolution_clock::time_point start;
     std::chrono::high_resolution_clock::time_point stop;
@@ -22,6 +22,9 @@ int main()
     }
 
     timer.ReportMedian();
+
+    std::ifstream file("../tests/msft.csv", std::ios::binary | std::ios::ate);
+    timer.ReportMedianThroughput(static_cast<double>(file.tellg()));
   }
   catch (const std::exception& ex)
   {
@@ -0,0 +1,48 @@
+// ptest003.cpp - file load using one thread per hardware thread
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    const std::string msft = unittest::ReadFile("../tests/msft.csv");
+    std::string csv = msft;
+    for (int i = 0; i < 63; ++i)
+    {
+      csv += msft.substr(msft.find('\n') + 1);
+    }
+    unittest::WriteFile(path, csv);
+
+    perftest::Timer timer;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      timer.Start();
+
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                             rapidcsv::LoadParams(false, 0));
+
+      timer.Stop();
+    }
+
+    timer.ReportMedian();
+    timer.ReportMedianThroughput(static_cast<double>(csv.size()));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,49 @@
+// ptest004.cpp - numeric conversion of cells by column
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    rapidcsv::Document doc("../tests/msft.csv", rapidcsv::LabelParams(0, 0));
+    const std::vector<std::string> columnNames = { "Open", "High", "Low", "Close", "Adj Close" };
+    const double cellCount = static_cast<double>(doc.GetRowCount() * (columnNames.size() + 1));
+
+    perftest::Timer timer;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      timer.Start();
+
+      double sum = 0;
+      for (const std::string& columnName : columnNames)
+      {
+        const std::vector<double>& column = doc.GetColumn<double>(columnName);
+        sum += column.back();
+      }
+
+      const std::vector<long long>& volume = doc.GetColumn<long long>("Volume");
+      sum += static_cast<double>(volume.back());
+
+      timer.Stop();
+
+      // dummy usage of variables
+      (void)sum;
+    }
+
+    timer.ReportMedian();
+    timer.ReportMedianPerItem(cellCount);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,71 @@
+// ptest006.cpp - numeric conversion with default values of sparse columns
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    // every tenth cell is empty, and every fiftieth invalid
+    const size_t rowCount = 100000;
+    const size_t columnCount = 8;
+    std::string csv;
+    for (size_t rowIdx = 0; rowIdx < rowCount; ++rowIdx)
+    {
+      for (size_t columnIdx = 0; columnIdx < columnCount; ++columnIdx)
+      {
+        const size_t cellIdx = (rowIdx * columnCount) + columnIdx;
+        if ((cellIdx % 10) == 3)
+        {
+          // empty
+        }
+        else if ((cellIdx % 50) == 7)
+        {
+          csv += "n/a";
+        }
+        else
+        {
+          csv += std::to_string(cellIdx) + "." + std::to_string(cellIdx % 1000);
+        }
+        csv += (columnIdx + 1 < columnCount) ? "," : "\n";
+      }
+    }
+
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(true /* pHasDefaultConverter */));
+
+    perftest::Timer timer;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      timer.Start();
+
+      double sum = 0;
+      for (size_t columnIdx = 0; columnIdx < columnCount; ++columnIdx)
+      {
+        const std::vector<double>& column = doc.GetColumn<double>(columnIdx);
+        sum += column.back();
+      }
+
+      timer.Stop();
+
+      // dummy usage of variables
+      (void)sum;
+    }
+
+    timer.ReportMedian();
+    timer.ReportMedianPerItem(static_cast<double>(rowCount * columnCount));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,53 @@
+// ptest007.cpp - get cells by resolved column references
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    rapidcsv::Document doc("../tests/msft.csv", rapidcsv::LabelParams(0, 0));
+    const std::vector<std::string> columnNames = { "Open", "High", "Low", "Close", "Adj Close" };
+
+    perftest::Timer timer;
+
+    for (int i = 0; i < 10; ++i)
+    {
+      timer.Start();
+
+      std::vector<rapidcsv::ColumnRef> columns;
+      for (const std::string& columnName : columnNames)
+      {
+        columns.push_back(doc.GetColumnRef(columnName));
+      }
+
+      double sum = 0;
+      for (size_t rowIdx = 0; rowIdx < doc.GetRowCount(); ++rowIdx)
+      {
+        for (const rapidcsv::ColumnRef& column : columns)
+        {
+          sum += doc.GetCell<double>(column, rowIdx);
+        }
+      }
+
+      timer.Stop();
+
+      // dummy usage of variables
+      (void)sum;
+    }
+
+    timer.ReportMedian();
+    timer.ReportMedianPerItem(static_cast<double>(doc.GetRowCount() * columnNames.size()));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
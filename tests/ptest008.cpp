@@ -0,0 +1,51 @@
+// ptest008.cpp - get same columns repeatedly with column cache
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    const std::vector<std::string> columnNames = { "Open", "High", "Low", "Close", "Adj Close" };
+
+    for (const bool columnCache : { false, true })
+    {
+      rapidcsv::Document doc("../tests/msft.csv", rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                             rapidcsv::StorageParams(rapidcsv::StorageLayout::RowMajor, columnCache));
+
+      perftest::Timer timer;
+
+      for (int i = 0; i < 10; ++i)
+      {
+        timer.Start();
+
+        double sum = 0;
+        for (const std::string& columnName : columnNames)
+        {
+          const std::vector<double> column = doc.GetColumn<double>(columnName);
+          sum += column.back();
+        }
+
+        timer.Stop();
+
+        // dummy usage of variables
+        (void)sum;
+      }
+
+      std::cout << (columnCache ? "cached:" : "uncached:") << std::endl;
+      timer.ReportMedian();
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,56 @@
+// ptest009.cpp - get rows into a reused vector
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    rapidcsv::Document doc("../tests/msft.csv", rapidcsv::LabelParams(0, 0));
+
+    for (const bool reuse : { false, true })
+    {
+      perftest::Timer timer;
+
+      std::vector<std::string> row;
+      for (int i = 0; i < 10; ++i)
+      {
+        timer.Start();
+
+        size_t size = 0;
+        for (size_t rowIdx = 0; rowIdx < doc.GetRowCount(); ++rowIdx)
+        {
+          if (reuse)
+          {
+            doc.GetRow<std::string>(rowIdx, row);
+          }
+          else
+          {
+            row = doc.GetRow<std::string>(rowIdx);
+          }
+          size += row.size();
+        }
+
+        timer.Stop();
+
+        // dummy usage of variables
+        (void)size;
+      }
+
+      std::cout << (reuse ? "reused vector:" : "returned vector:") << std::endl;
+      timer.ReportMedian();
+      timer.ReportMedianPerItem(static_cast<double>(doc.GetRowCount()));
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,44 @@
+// ptest010.cpp - load all columns and selected columns
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    for (const bool project : { false, true })
+    {
+      const std::vector<std::string> columnNames = project ? std::vector<std::string>({ "Close" }) :
+                                                             std::vector<std::string>();
+      perftest::Timer timer;
+
+      for (int i = 0; i < 10; ++i)
+      {
+        timer.Start();
+
+        rapidcsv::Document doc("../tests/msft.csv", rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                               rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                               rapidcsv::LoadParams(false, 1, 0, {}, columnNames));
+
+        timer.Stop();
+
+        // dummy usage of variables
+        (void)doc;
+      }
+
+      std::cout << (project ? "selected column:" : "all columns:") << std::endl;
+      timer.ReportMedian();
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
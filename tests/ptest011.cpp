@@ -0,0 +1,65 @@
+// ptest011.cpp - point lookups in a loaded document and with a row offset index
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string indexPath = unittest::TempPath();
+
+  try
+  {
+    const std::vector<size_t> rowIdxs = { 7, 1500, 3000, 4500, 6000, 7500 };
+
+    for (const bool indexed : { false, true })
+    {
+      perftest::Timer timer;
+
+      // the first indexed iteration builds and saves the index, others load it
+      for (int i = 0; i < 10; ++i)
+      {
+        timer.Start();
+
+        double sum = 0;
+        if (indexed)
+        {
+          rapidcsv::IndexedReader reader("../tests/msft.csv", rapidcsv::LabelParams(0, 0),
+                                         rapidcsv::SeparatorParams(), rapidcsv::ConverterParams(),
+                                         rapidcsv::LineReaderParams(), rapidcsv::IndexParams(256, 4, indexPath));
+          for (const size_t rowIdx : rowIdxs)
+          {
+            sum += reader.GetCell<double>("Close", rowIdx);
+          }
+        }
+        else
+        {
+          rapidcsv::Document doc("../tests/msft.csv", rapidcsv::LabelParams(0, 0));
+          for (const size_t rowIdx : rowIdxs)
+          {
+            sum += doc.GetCell<double>("Close", rowIdx);
+          }
+        }
+
+        timer.Stop();
+
+        // dummy usage of variables
+        (void)sum;
+      }
+
+      std::cout << (indexed ? "indexed reader:" : "loaded document:") << std::endl;
+      timer.ReportMedian();
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(indexPath);
+
+  return rv;
+}
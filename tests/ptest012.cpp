@@ -0,0 +1,66 @@
+// ptest012.cpp - file load from csv and from binary snapshot
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+  std::string snapshotPath = unittest::TempPath();
+
+  try
+  {
+    const std::string msft = unittest::ReadFile("../tests/msft.csv");
+    std::string csv = msft;
+    for (int i = 0; i < 999; ++i)
+    {
+      csv += msft.substr(msft.find('\n') + 1);
+    }
+    unittest::WriteFile(path, csv);
+
+    const rapidcsv::StorageParams storageParams(rapidcsv::StorageLayout::Buffer);
+    rapidcsv::Document(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(), rapidcsv::ConverterParams(),
+                       rapidcsv::LineReaderParams(), rapidcsv::LoadParams(), storageParams).SaveSnapshot(snapshotPath);
+
+    for (const bool snapshot : { false, true })
+    {
+      perftest::Timer timer;
+
+      for (int i = 0; i < 3; ++i)
+      {
+        timer.Start();
+
+        if (snapshot)
+        {
+          rapidcsv::Document doc;
+          doc.LoadSnapshot(snapshotPath, rapidcsv::ConverterParams(), storageParams);
+        }
+        else
+        {
+          rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                 rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                                 storageParams);
+        }
+
+        timer.Stop();
+      }
+
+      std::cout << (snapshot ? "snapshot:" : "csv:") << std::endl;
+      timer.ReportMedian();
+      timer.ReportMedianThroughput(static_cast<double>(csv.size()));
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(snapshotPath);
+
+  return rv;
+}
@@ -0,0 +1,54 @@
+// ptest013.cpp - file save
+
+#include <rapidcsv.h>
+#include "perftest.h"
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    for (const bool quoted : { false, true })
+    {
+      rapidcsv::Document doc("../tests/msft.csv");
+      if (quoted)
+      {
+        // cells requiring quotes and escaped quotes
+        std::vector<std::string> column = doc.GetColumn<std::string>(0);
+        for (std::string& cell : column)
+        {
+          cell = "date \"" + cell + "\"";
+        }
+        doc.SetColumn<std::string>(0, column);
+      }
+
+      perftest::Timer timer;
+
+      for (int i = 0; i < 10; ++i)
+      {
+        timer.Start();
+
+        doc.Save(path);
+
+        timer.Stop();
+      }
+
+      std::cout << (quoted ? "quoted cells:" : "plain cells:") << std::endl;
+      timer.ReportMedian();
+      timer.ReportMedianThroughput(static_cast<double>(unittest::ReadFile(path).size()));
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
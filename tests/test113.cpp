@@ -0,0 +1,49 @@
+// test113.cpp - read cells spanning vectorized scan and read buffer boundaries
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv = "A;B;C\n";
+  std::vector<std::string> col0;
+  std::vector<std::string> col1;
+  std::vector<std::string> col2;
+  for (size_t i = 0; i < 2000; ++i)
+  {
+    // vary cell lengths to place separators and quotes at every offset within a vector
+    const std::string plain = std::string(i % 67, 'x') + std::to_string(i);
+    const std::string quoted = std::string(i % 13, 'q') + ";\"\"" + std::string(i % 37, 'y');
+    const std::string spaced = std::string(i % 5, ' ') + std::to_string(i * 3);
+    csv += plain + ";\"" + quoted + "\";" + spaced + ((i % 2) ? "\r\n" : "\n");
+    col0.push_back(plain);
+    col1.push_back(std::string(i % 13, 'q') + ";\"" + std::string(i % 37, 'y'));
+    col2.push_back(spaced);
+  }
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    unittest::ExpectTrue(csv.size() > (64 * 1024));
+
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(), rapidcsv::SeparatorParams(';'));
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 2000);
+    unittest::ExpectEqual(size_t, doc.GetColumnCount(), 3);
+    unittest::ExpectTrue(doc.GetColumn<std::string>("A") == col0);
+    unittest::ExpectTrue(doc.GetColumn<std::string>("B") == col1);
+    unittest::ExpectTrue(doc.GetColumn<std::string>("C") == col2);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
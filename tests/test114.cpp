@@ -0,0 +1,88 @@
+// test114.cpp - read memory mapped file
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,\"9,\",81\n"
+    "2,4,16,256\n"
+  ;
+
+  // "-,A\n"
+  // "1,\xe4\xb8\xad\n"
+  const unsigned char u16le[] =
+  {
+    0xff, 0xfe,
+    0x2d, 0x00, 0x2c, 0x00, 0x41, 0x00, 0x0a, 0x00,
+    0x31, 0x00, 0x2c, 0x00, 0x2d, 0x4e, 0x0a, 0x00
+  };
+  const unsigned int u16le_len = 18;
+  const std::string csvle(reinterpret_cast<const char*>(u16le), u16le_len);
+
+  std::string path = unittest::TempPath();
+
+  try
+  {
+    const rapidcsv::LoadParams loadParams(true /* pMemoryMap */);
+
+    // plain file
+    unittest::WriteFile(path, csv);
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), loadParams);
+      unittest::ExpectEqual(int, doc.GetCell<int>("A", "1"), 3);
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "1"), "9,");
+      unittest::ExpectEqual(int, doc.GetCell<int>("C", "2"), 256);
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 2);
+    }
+
+    // file with UTF-8 byte order mark
+    unittest::WriteFile(path, "\xef\xbb\xbf" + csv);
+    {
+      rapidcsv::Document doc;
+      doc.Load(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+               rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), loadParams);
+      unittest::ExpectEqual(std::string, doc.GetColumnName(0), "A");
+      unittest::ExpectEqual(int, doc.GetCell<int>("A", "2"), 4);
+
+      doc.Save();
+      unittest::ExpectEqual(std::string, unittest::ReadFile(path), "\xef\xbb\xbf" + csv);
+    }
+
+    // UTF-16 LE file
+    unittest::WriteFile(path, csvle);
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), loadParams);
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("A", "1"), "\xe4\xb8\xad");
+    }
+
+    // empty file
+    unittest::WriteFile(path, "");
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), loadParams);
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 0);
+    }
+
+    // non-existing file
+    unittest::DeleteFile(path);
+    ExpectException(rapidcsv::Document(path, rapidcsv::LabelParams(), rapidcsv::SeparatorParams(),
+                                       rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                       loadParams), std::ios_base::failure);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,69 @@
+// test115.cpp - read and modify document stored in buffer layout
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,\"9,\"\"x\"\"\",81\n"
+    "2,4,16,\n"
+    "3,5\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    const rapidcsv::StorageParams storageParams(rapidcsv::StorageLayout::Buffer);
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                           rapidcsv::LoadParams(), storageParams);
+
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+    unittest::ExpectEqual(size_t, doc.GetColumnCount(), 3);
+    unittest::ExpectEqual(int, doc.GetCell<int>(0, 0), 3);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "1"), "9,\"x\"");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("C", "2"), "");
+    unittest::ExpectEqual(int, doc.GetColumnIdx("C"), 2);
+    unittest::ExpectEqual(int, doc.GetRowIdx("3"), 2);
+    unittest::ExpectEqual(std::string, doc.GetColumnName(1), "B");
+    unittest::ExpectEqual(std::string, doc.GetRowName(1), "2");
+    unittest::ExpectTrue(doc.GetColumnNames() == std::vector<std::string>({ "A", "B", "C" }));
+    unittest::ExpectTrue(doc.GetRowNames() == std::vector<std::string>({ "1", "2", "3" }));
+    unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 3, 4, 5 }));
+    unittest::ExpectTrue(doc.GetRow<std::string>("3") == std::vector<std::string>({ "5" }));
+    ExpectException(doc.GetColumn<std::string>("C"), std::out_of_range);
+    ExpectException(doc.GetCell<int>(0, 3), std::out_of_range);
+
+    std::ostringstream unmodified;
+    doc.Save(unmodified);
+    unittest::ExpectEqual(std::string, unmodified.str(), csv);
+
+    // modification converts the document to row-major layout
+    doc.SetCell<int>("A", "3", 6);
+    doc.RemoveRow("1");
+    unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 4, 6 }));
+    unittest::ExpectEqual(int, doc.GetRowIdx("3"), 1);
+
+    // reload restores the requested layout
+    doc.Load(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+             rapidcsv::LoadParams(), storageParams);
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "1"), "9,\"x\"");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
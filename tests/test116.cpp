@@ -0,0 +1,97 @@
+// test116.cpp - read and modify document stored in column-major layout
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static std::string ToCsv(const rapidcsv::Document& pDoc)
+{
+  std::ostringstream ss;
+  pDoc.Save(ss);
+  return ss.str();
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+    "3,5,25,625\n"
+  ;
+
+  std::string raggedCsv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4\n"
+    "3,5,25\n"
+  ;
+
+  try
+  {
+    const rapidcsv::StorageParams storageParams(rapidcsv::StorageLayout::ColumnMajor);
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                           rapidcsv::LoadParams(), storageParams);
+
+    unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+    unittest::ExpectEqual(size_t, doc.GetColumnCount(), 3);
+    unittest::ExpectEqual(int, doc.GetCell<int>("B", "2"), 16);
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 81, 256, 625 }));
+    unittest::ExpectTrue(doc.GetRow<int>("3") == std::vector<int>({ 5, 25, 625 }));
+    unittest::ExpectTrue(doc.GetColumnNames() == std::vector<std::string>({ "A", "B", "C" }));
+    ExpectException(doc.GetCell<int>(3, 0), std::out_of_range);
+    unittest::ExpectEqual(std::string, ToCsv(doc), csv);
+
+    // column modifications are performed in column-major layout
+    doc.SetColumn<int>("B", std::vector<int>({ 10, 20, 30 }));
+    doc.RemoveColumn("A");
+    doc.InsertColumn<int>(1, std::vector<int>({ 7, 8, 9 }), "X");
+    doc.SetCell<int>(3, 1, 42);
+    doc.SetColumnName(0, "Y");
+    unittest::ExpectTrue(doc.GetColumnNames() == std::vector<std::string>({ "Y", "X", "C", "" }));
+    unittest::ExpectTrue(doc.GetColumn<int>("X") == std::vector<int>({ 7, 8, 9 }));
+    unittest::ExpectTrue(doc.GetRow<std::string>("2") == std::vector<std::string>({ "20", "8", "256", "42" }));
+    unittest::ExpectEqual(std::string, ToCsv(doc),
+                          "-,Y,X,C,\n"
+                          "1,10,7,81,\n"
+                          "2,20,8,256,42\n"
+                          "3,30,9,625,\n");
+
+    // row modifications convert the document to row-major layout
+    doc.RemoveRow("1");
+    unittest::ExpectTrue(doc.GetColumn<int>("Y") == std::vector<int>({ 20, 30 }));
+    unittest::ExpectEqual(int, doc.GetRowIdx("3"), 1);
+
+    // ragged rows give the same results as row-major layout
+    std::istringstream raggedStream(raggedCsv);
+    rapidcsv::Document ragged(raggedStream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                              rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                              rapidcsv::LoadParams(), storageParams);
+    std::istringstream refStream(raggedCsv);
+    rapidcsv::Document ref(refStream, rapidcsv::LabelParams(0, 0));
+
+    ExpectException(ragged.GetColumn<int>("B"), std::out_of_range);
+    ExpectExceptionMsg(ragged.RemoveColumn("B"), std::out_of_range, "column out of range: 1 (on row 2)");
+    unittest::ExpectEqual(std::string, ToCsv(ragged), raggedCsv);
+
+    ragged.RemoveColumn("A");
+    ref.RemoveColumn("A");
+    ragged.InsertColumn<int>(0, std::vector<int>({ 1, 2, 3 }), "Z");
+    ref.InsertColumn<int>(0, std::vector<int>({ 1, 2, 3 }), "Z");
+    ragged.SetCell<int>(4, 2, 99);
+    ref.SetCell<int>(4, 2, 99);
+    unittest::ExpectEqual(std::string, ToCsv(ragged), ToCsv(ref));
+    unittest::ExpectTrue(ragged.GetColumn<int>("Z") == ref.GetColumn<int>("Z"));
+    unittest::ExpectTrue(ragged.GetRow<std::string>("2") == ref.GetRow<std::string>("2"));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
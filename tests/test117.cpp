@@ -0,0 +1,83 @@
+// test117.cpp - concurrent parsing gives the same result as serial parsing
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+static std::string ToCsv(const rapidcsv::Document& pDoc)
+{
+  std::ostringstream ss;
+  pDoc.Save(ss);
+  return ss.str();
+}
+
+static std::string Load(const std::string& pCsv, const rapidcsv::SeparatorParams& pSeparatorParams,
+                        const rapidcsv::LineReaderParams& pLineReaderParams, const size_t pThreadCount,
+                        const rapidcsv::StorageLayout pLayout)
+{
+  std::istringstream sstream(pCsv);
+  rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), pSeparatorParams,
+                         rapidcsv::ConverterParams(), pLineReaderParams,
+                         rapidcsv::LoadParams(false, pThreadCount), rapidcsv::StorageParams(pLayout));
+  return ToCsv(doc) + std::to_string(doc.GetRowCount()) + "," + std::to_string(doc.GetRowIdx("x100"));
+}
+
+int main()
+{
+  int rv = 0;
+
+  // rows of about 64 bytes with two of three linebreaks within quoted cells, making
+  // chunks likely to start within a row
+  std::string quotedCsv = "-,A,B,C\r\n";
+  std::string plainCsv = "-,A,B,C\n";
+  for (int i = 0; i < 100000; ++i)
+  {
+    const std::string idx = std::to_string(i);
+    quotedCsv += "x" + idx + ",\"first " + idx + "\r\nsecond\nthird\",\"a \"\"b\"\", c\"," + idx + "\r\n";
+    plainCsv += "x" + idx + ",\"a, " + idx + "\",b" + idx + "," + ((i % 10 == 0) ? "\n#comment\n\n" : "\n");
+  }
+
+  try
+  {
+    const rapidcsv::SeparatorParams quotedParams(',', false, rapidcsv::sPlatformHasCR, true);
+    const rapidcsv::LineReaderParams skipParams(true, '#', true);
+    const std::string quotedRef = Load(quotedCsv, quotedParams, rapidcsv::LineReaderParams(), 1,
+                                       rapidcsv::StorageLayout::RowMajor);
+    const std::string plainRef = Load(plainCsv, rapidcsv::SeparatorParams(), skipParams, 1,
+                                      rapidcsv::StorageLayout::RowMajor);
+    unittest::ExpectTrue(quotedRef.size() > quotedCsv.size());
+    unittest::ExpectEqual(std::string, quotedRef.substr(quotedRef.size() - 10), "100000,100");
+
+    const rapidcsv::StorageLayout layouts[] =
+    {
+      rapidcsv::StorageLayout::RowMajor, rapidcsv::StorageLayout::Buffer, rapidcsv::StorageLayout::ColumnMajor
+    };
+    for (const rapidcsv::StorageLayout layout : layouts)
+    {
+      for (size_t threadCount = 2; threadCount <= 9; threadCount += 7)
+      {
+        unittest::ExpectEqual(std::string, Load(quotedCsv, quotedParams, rapidcsv::LineReaderParams(),
+                                                threadCount, layout), quotedRef);
+        unittest::ExpectEqual(std::string, Load(plainCsv, rapidcsv::SeparatorParams(), skipParams,
+                                                threadCount, layout), plainRef);
+      }
+    }
+
+    // zero selects the number of hardware threads
+    unittest::ExpectEqual(std::string, Load(plainCsv, rapidcsv::SeparatorParams(), skipParams, 0,
+                                            rapidcsv::StorageLayout::RowMajor), plainRef);
+
+    // data too small to be split is parsed serially
+    std::istringstream sstream("-,A\n1,2\n");
+    rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                           rapidcsv::LoadParams(false, 8));
+    unittest::ExpectEqual(int, doc.GetCell<int>("A", "1"), 2);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,60 @@
+// test118.cpp - unsupported conversion datatypes with default converter
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+struct Struct
+{
+  int val = 0;
+};
+
+enum Enum
+{
+  EnumA,
+};
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B\n"
+    "1,x,\n"
+    "2,-3,2.5\n"
+  ;
+
+  try
+  {
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(true, 0.5, 7));
+
+    // invalid values of supported datatypes are replaced by default values
+    unittest::ExpectEqual(int, doc.GetCell<int>("A", "1"), 7);
+    unittest::ExpectEqual(unsigned, doc.GetCell<unsigned>("A", "2"), 7);
+    unittest::ExpectEqual(double, doc.GetCell<double>("B", "1"), 0.5);
+    unittest::ExpectEqual(char, doc.GetCell<char>("A", "1"), 'x');
+    unittest::ExpectEqual(int, static_cast<int>(doc.GetCell<signed char>("A", "2")), -3);
+
+    // unsupported datatypes are reported regardless of default converter
+    ExpectException(doc.GetCell<bool>("A", "1"), rapidcsv::no_converter);
+    ExpectException(doc.GetCell<Enum>("A", "1"), rapidcsv::no_converter);
+    ExpectException(doc.GetColumn<Struct>("B"), rapidcsv::no_converter);
+    ExpectException(doc.SetCell<bool>("A", "1", true), rapidcsv::no_converter);
+    ExpectException(doc.SetCell<Enum>("A", "1", EnumA), rapidcsv::no_converter);
+
+    doc.SetCell<signed char>("A", "1", -5);
+    doc.SetCell<unsigned char>("B", "1", 200);
+    doc.SetCell<char>("B", "2", 'y');
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("A", "1"), "-5");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "1"), "200");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "2"), "y");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
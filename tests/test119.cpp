@@ -0,0 +1,154 @@
+// test119.cpp - locale-independent numeric conversion matches stream conversion
+
+#include <random>
+#include <rapidcsv.h>
+#include "unittest.h"
+
+template<typename T>
+static std::string Describe(const T& pVal)
+{
+  std::ostringstream ss;
+  ss << std::setprecision(21) << pVal;
+  return ss.str();
+}
+
+template<typename T>
+static std::string ToVal(const rapidcsv::Converter<T>& pConverter, const std::string& pStr)
+{
+  try
+  {
+    T val;
+    pConverter.ToVal(pStr, val);
+    return Describe(val);
+  }
+  catch (const std::invalid_argument&)
+  {
+    return "invalid_argument";
+  }
+  catch (const std::out_of_range&)
+  {
+    return "out_of_range";
+  }
+}
+
+template<typename T>
+static std::string StreamToVal(const std::string& pStr)
+{
+  std::istringstream iss(pStr);
+  iss.imbue(std::locale::classic());
+  T val;
+  iss >> val;
+  return (iss.fail() || iss.bad() || !iss.eof()) ? "invalid_argument" : Describe(val);
+}
+
+template<typename T>
+static std::string ToStr(const rapidcsv::Converter<T>& pConverter, const T& pVal)
+{
+  std::string str;
+  pConverter.ToStr(pVal, str);
+  return str;
+}
+
+int main()
+{
+  int rv = 0;
+
+  try
+  {
+    const rapidcsv::ConverterParams localeParams(false, 0, 0, true);
+    const rapidcsv::ConverterParams classicParams(false, 0, 0, false);
+
+    // floating-point values are parsed like an input stream with the classic locale
+    std::vector<std::string> floats =
+    {
+      "0", "-0", "+1.5", " 2.25", "1.5 ", ".5", "5.", ".", "-.5", "1e3", "1E-3", "1e", "1e+", "+-1",
+      "12345678901234567890", "0.1", "3.14159265358979323846", "1e22", "1e23", "1e-22", "1e400",
+      "-1e400", "1e-400", "inf", "nan", "0x10", "", " ", "1,5", "4.9e-324", "1.7976931348623157e308",
+      "9007199254740993", "16777217", "2.5e10", "123.456e-5"
+    };
+
+    std::mt19937 rng(119);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    for (int i = 0; i < 2000; ++i)
+    {
+      const double val = dist(rng) * std::pow(10.0, static_cast<int>(rng() % 40) - 20);
+      for (const int precision : { 3, 9, 17 })
+      {
+        std::ostringstream ss;
+        ss << std::setprecision(precision) << val;
+        floats.push_back(ss.str());
+      }
+      floats.push_back(std::to_string(val));
+    }
+
+    const rapidcsv::Converter<float> floatConverter(classicParams);
+    const rapidcsv::Converter<double> doubleConverter(classicParams);
+    const rapidcsv::Converter<long double> longDoubleConverter(classicParams);
+    for (const std::string& str : floats)
+    {
+      unittest::ExpectEqual(std::string, ToVal(floatConverter, str), StreamToVal<float>(str));
+      unittest::ExpectEqual(std::string, ToVal(doubleConverter, str), StreamToVal<double>(str));
+      unittest::ExpectEqual(std::string, ToVal(longDoubleConverter, str), StreamToVal<long double>(str));
+    }
+
+    // integers are parsed like std::stoi() and related functions
+    const std::vector<std::string> integers =
+    {
+      "0", "-0", "+7", "  -7", "12abc", "abc", "", "-", "+", " + 5", "127", "128", "-128", "-129", "255",
+      "256", "32767", "32768", "-32769", "65535", "65536", "2147483647", "2147483648", "-2147483648",
+      "-2147483649", "4294967295", "4294967296", "9223372036854775807", "9223372036854775808",
+      "-9223372036854775808", "-9223372036854775809", "18446744073709551615", "18446744073709551616",
+      "-1", "0x10", "1.9", "1e3"
+    };
+
+    for (const std::string& str : integers)
+    {
+      unittest::ExpectEqual(std::string, ToVal(rapidcsv::Converter<int>(classicParams), str),
+                            ToVal(rapidcsv::Converter<int>(localeParams), str));
+      unittest::ExpectEqual(std::string, ToVal(rapidcsv::Converter<long>(classicParams), str),
+                            ToVal(rapidcsv::Converter<long>(localeParams), str));
+      unittest::ExpectEqual(std::string, ToVal(rapidcsv::Converter<long long>(classicParams), str),
+                            ToVal(rapidcsv::Converter<long long>(localeParams), str));
+      unittest::ExpectEqual(std::string, ToVal(rapidcsv::Converter<short>(classicParams), str),
+                            ToVal(rapidcsv::Converter<short>(localeParams), str));
+      unittest::ExpectEqual(std::string, ToVal(rapidcsv::Converter<unsigned short>(classicParams), str),
+                            ToVal(rapidcsv::Converter<unsigned short>(localeParams), str));
+      unittest::ExpectEqual(std::string, ToVal(rapidcsv::Converter<unsigned>(classicParams), str),
+                            ToVal(rapidcsv::Converter<unsigned>(localeParams), str));
+      unittest::ExpectEqual(std::string, ToVal(rapidcsv::Converter<unsigned long long>(classicParams), str),
+                            ToVal(rapidcsv::Converter<unsigned long long>(localeParams), str));
+    }
+
+    // numbers are formatted like an output stream with the classic locale
+    for (int i = 0; i < 2000; ++i)
+    {
+      const double val = dist(rng) * std::pow(10.0, static_cast<int>(rng() % 40) - 20);
+      unittest::ExpectEqual(std::string, ToStr(rapidcsv::Converter<double>(classicParams), val),
+                            ToStr(rapidcsv::Converter<double>(localeParams), val));
+      unittest::ExpectEqual(std::string, ToStr(rapidcsv::Converter<float>(classicParams), static_cast<float>(val)),
+                            ToStr(rapidcsv::Converter<float>(localeParams), static_cast<float>(val)));
+      unittest::ExpectEqual(std::string,
+                            ToStr(rapidcsv::Converter<long double>(classicParams), static_cast<long double>(val)),
+                            ToStr(rapidcsv::Converter<long double>(localeParams), static_cast<long double>(val)));
+      unittest::ExpectEqual(std::string,
+                            ToStr(rapidcsv::Converter<long long>(classicParams), static_cast<long long>(val)),
+                            ToStr(rapidcsv::Converter<long long>(localeParams), static_cast<long long>(val)));
+    }
+
+    unittest::ExpectEqual(std::string, ToStr(rapidcsv::Converter<double>(classicParams), 0.1),
+                          "0.10000000000000001");
+    unittest::ExpectEqual(std::string, ToStr(rapidcsv::Converter<float>(classicParams), 0.1f), "0.100000001");
+    unittest::ExpectEqual(std::string, ToStr(rapidcsv::Converter<long double>(classicParams), 1e20L), "1e+20");
+    unittest::ExpectEqual(std::string, ToStr(rapidcsv::Converter<signed char>(classicParams),
+                                             static_cast<signed char>(-5)), "-5");
+    unittest::ExpectEqual(std::string, ToStr(rapidcsv::Converter<unsigned char>(classicParams),
+                                             static_cast<unsigned char>(200)), "200");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
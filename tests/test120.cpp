@@ -0,0 +1,92 @@
+// test120.cpp - default converter values for invalid and out of range numbers
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C,D\n"
+    "1,,n/a, 12x,-\n"
+    "2,99999999999999999999,-1,300,1e99999\n"
+    "3, 42,0x10,-0,.5\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    for (const bool numericLocale : { true, false })
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(true /* pHasDefaultConverter */,
+                                                       -1.5 /* pDefaultFloat */,
+                                                       -7 /* pDefaultInteger */,
+                                                       numericLocale));
+
+      // invalid
+      unittest::ExpectEqual(int, doc.GetCell<int>("A", "1"), -7);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "1"), -7);
+      unittest::ExpectEqual(int, doc.GetCell<int>("C", "1"), 12);
+      unittest::ExpectEqual(int, doc.GetCell<int>("D", "1"), -7);
+      unittest::ExpectEqual(double, doc.GetCell<double>("A", "1"), -1.5);
+      unittest::ExpectEqual(double, doc.GetCell<double>("B", "1"), -1.5);
+      unittest::ExpectEqual(float, doc.GetCell<float>("D", "1"), -1.5f);
+      unittest::ExpectEqual(long double, doc.GetCell<long double>("A", "1"), -1.5L);
+
+      // out of range
+      unittest::ExpectEqual(long long, doc.GetCell<long long>("A", "2"), -7);
+      unittest::ExpectEqual(unsigned, doc.GetCell<unsigned>("B", "2"), static_cast<unsigned>(-7));
+      unittest::ExpectEqual(unsigned char, doc.GetCell<unsigned char>("C", "2"),
+                            static_cast<unsigned char>(-7));
+      unittest::ExpectEqual(short, doc.GetCell<short>("C", "2"), 300);
+      unittest::ExpectEqual(double, doc.GetCell<double>("D", "2"), -1.5);
+
+      // valid
+      unittest::ExpectEqual(int, doc.GetCell<int>("A", "3"), 42);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "3"), 0);
+      unittest::ExpectEqual(unsigned long, doc.GetCell<unsigned long>("C", "3"), 0);
+      unittest::ExpectEqual(double, doc.GetCell<double>("D", "3"), 0.5);
+
+      const std::vector<int> column = doc.GetColumn<int>("A");
+      unittest::ExpectEqual(size_t, column.size(), 3);
+      unittest::ExpectEqual(int, column.at(0), -7);
+      unittest::ExpectEqual(int, column.at(1), -7);
+      unittest::ExpectEqual(int, column.at(2), 42);
+    }
+
+    // without default converter the exceptions are unchanged
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0));
+    ExpectException(doc.GetCell<int>("A", "1"), std::invalid_argument);
+    ExpectException(doc.GetCell<double>("B", "1"), std::invalid_argument);
+    ExpectException(doc.GetCell<long long>("A", "2"), std::out_of_range);
+    ExpectException(doc.GetCell<unsigned>("B", "2"), std::out_of_range);
+    ExpectException(doc.GetCell<unsigned char>("C", "2"), std::out_of_range);
+    ExpectException(doc.GetCell<double>("D", "2"), std::out_of_range);
+
+    rapidcsv::Document docClassic(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                  rapidcsv::ConverterParams(false, 0.0, 0, false /* pNumericLocale */));
+    ExpectExceptionMsg(docClassic.GetCell<int>("A", "1"), std::invalid_argument, "conversion: no digits");
+    ExpectExceptionMsg(docClassic.GetCell<int>("D", "1"), std::invalid_argument, "conversion: no digits");
+    ExpectExceptionMsg(docClassic.GetCell<double>("B", "1"), std::invalid_argument,
+                       "istringstream: no conversion");
+    ExpectExceptionMsg(docClassic.GetCell<long long>("A", "2"), std::out_of_range,
+                       "conversion: out of range");
+    ExpectExceptionMsg(docClassic.GetCell<unsigned>("B", "2"), std::out_of_range,
+                       "conversion: out of range");
+    ExpectExceptionMsg(docClassic.GetCell<double>("D", "2"), std::invalid_argument,
+                       "istringstream: no conversion");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,148 @@
+// test121.cpp - streaming rows with reader
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+namespace
+{
+  void ExpectReaderEqualsDocument(const std::string& pCsv, const rapidcsv::LabelParams& pLabelParams,
+                                  const rapidcsv::SeparatorParams& pSeparatorParams =
+                                    rapidcsv::SeparatorParams(),
+                                  const rapidcsv::LineReaderParams& pLineReaderParams =
+                                    rapidcsv::LineReaderParams())
+  {
+    std::istringstream docStream(pCsv);
+    rapidcsv::Document doc(docStream, pLabelParams, pSeparatorParams, rapidcsv::ConverterParams(),
+                           pLineReaderParams);
+
+    std::istringstream readerStream(pCsv);
+    rapidcsv::Reader reader(readerStream, pLabelParams, pSeparatorParams, rapidcsv::ConverterParams(),
+                            pLineReaderParams);
+
+    if (pLabelParams.mColumnNameIdx >= 0)
+    {
+      unittest::ExpectTrue(reader.GetColumnNames() == doc.GetColumnNames());
+    }
+
+    size_t rowIdx = 0;
+    while (reader.ReadRow())
+    {
+      unittest::ExpectTrue(rowIdx < doc.GetRowCount());
+      unittest::ExpectTrue(reader.GetRow<std::string>() == doc.GetRow<std::string>(rowIdx));
+      if (pLabelParams.mRowNameIdx >= 0)
+      {
+        unittest::ExpectEqual(std::string, reader.GetRowName(), doc.GetRowName(rowIdx));
+      }
+      ++rowIdx;
+    }
+
+    unittest::ExpectEqual(size_t, rowIdx, doc.GetRowCount());
+    unittest::ExpectTrue(!reader.ReadRow());
+  }
+
+  void AppendUtf16LE(const std::string& pAscii, std::string& pUtf16)
+  {
+    for (const char ch : pAscii)
+    {
+      pUtf16 += ch;
+      pUtf16 += '\0';
+    }
+  }
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    // typed access by resolved index, name and row label
+    rapidcsv::Reader reader(path, rapidcsv::LabelParams(0, 0));
+    unittest::ExpectEqual(int, reader.GetColumnIdx("A"), 0);
+    unittest::ExpectEqual(int, reader.GetColumnIdx("C"), 2);
+    unittest::ExpectEqual(int, reader.GetColumnIdx("D"), -1);
+    const size_t columnIdxB = static_cast<size_t>(reader.GetColumnIdx("B"));
+
+    unittest::ExpectTrue(reader.ReadRow());
+    unittest::ExpectEqual(size_t, reader.GetColumnCount(), 3);
+    unittest::ExpectEqual(std::string, reader.GetRowName(), "1");
+    unittest::ExpectEqual(int, reader.GetCell<int>(0), 3);
+    unittest::ExpectEqual(int, reader.GetCell<int>(columnIdxB), 9);
+    unittest::ExpectEqual(long long, reader.GetCell<long long>("C"), 81);
+    unittest::ExpectEqual(double, reader.GetCell<double>(2, [](const std::string& pStr, double& pVal)
+    {
+      pVal = std::stod(pStr) / 2;
+    }), 40.5);
+
+    unittest::ExpectTrue(reader.ReadRow());
+    unittest::ExpectEqual(std::string, reader.GetRowName(), "2");
+    unittest::ExpectEqual(int, reader.GetCell<int>(columnIdxB), 16);
+    unittest::ExpectTrue(reader.GetRow<int>() == std::vector<int>({ 4, 16, 256 }));
+    ExpectException(reader.GetCell<int>(3), std::out_of_range);
+    ExpectException(reader.GetCell<int>("D"), std::out_of_range);
+
+    unittest::ExpectTrue(!reader.ReadRow());
+
+    ExpectException(rapidcsv::Reader("/nonexistent/rapidcsv.csv"), std::ios_base::failure);
+
+    // labels, separators and line reader settings
+    ExpectReaderEqualsDocument(csv, rapidcsv::LabelParams(0, 0));
+    ExpectReaderEqualsDocument(csv, rapidcsv::LabelParams(-1, -1));
+    ExpectReaderEqualsDocument(csv, rapidcsv::LabelParams(1, 2));
+
+    // label row beyond end of data
+    std::istringstream shortStream(csv);
+    rapidcsv::Reader shortReader(shortStream, rapidcsv::LabelParams(5, -1));
+    unittest::ExpectTrue(shortReader.GetColumnNames().empty());
+    unittest::ExpectEqual(int, shortReader.GetColumnIdx("A"), -1);
+    unittest::ExpectTrue(!shortReader.ReadRow());
+
+    ExpectReaderEqualsDocument("", rapidcsv::LabelParams(-1, -1));
+    ExpectReaderEqualsDocument("\xef\xbb\xbf" "A;B\r\n\"x;\";\" y \"\r\n\r\n# z\r\n1;2", rapidcsv::LabelParams(),
+                               rapidcsv::SeparatorParams(';', true, true),
+                               rapidcsv::LineReaderParams(true, '#', true));
+
+    // rows and quoted linebreaks spanning chunks of input data
+    std::string largeCsv = "A,B,C\n";
+    for (int i = 0; i < 20000; ++i)
+    {
+      largeCsv += std::to_string(i) + ",\"multi\nline " + std::to_string(i * 7) + "\"," +
+                  std::string(static_cast<size_t>(i % 13), 'x') + "\n";
+    }
+    largeCsv += "," + std::string(200000, 'y') + ",\n";
+    ExpectReaderEqualsDocument(largeCsv, rapidcsv::LabelParams(0, -1),
+                               rapidcsv::SeparatorParams(',', false, true, true));
+
+    // utf-16 with surrogate pairs spanning chunks of input data
+    std::string utf16Csv = "\xff\xfe";
+    AppendUtf16LE("A,B\n", utf16Csv);
+    for (size_t prefixLength = 1; prefixLength <= 4; ++prefixLength)
+    {
+      AppendUtf16LE(std::string(prefixLength, 'p') + ",", utf16Csv);
+      for (int i = 0; i < 20000; ++i)
+      {
+        utf16Csv += std::string("\x3d\xd8\x00\xde", 4);
+      }
+      AppendUtf16LE("\n", utf16Csv);
+    }
+    ExpectReaderEqualsDocument(utf16Csv, rapidcsv::LabelParams(0, -1));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
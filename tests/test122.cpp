@@ -0,0 +1,135 @@
+// test122.cpp - streaming rows with writer
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+namespace
+{
+  std::string WriteRows(const rapidcsv::Document& pDoc, const rapidcsv::SeparatorParams& pSeparatorParams,
+                        const rapidcsv::WriterParams& pWriterParams = rapidcsv::WriterParams())
+  {
+    std::ostringstream stream;
+    rapidcsv::Writer writer(stream, pSeparatorParams, rapidcsv::ConverterParams(), pWriterParams);
+    for (size_t rowIdx = 0; rowIdx < pDoc.GetRowCount(); ++rowIdx)
+    {
+      writer.WriteRow(pDoc.GetRow<std::string>(rowIdx));
+    }
+    writer.Flush();
+    return stream.str();
+  }
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "A,B,C\n"
+    "1,\"x, y\",\"say \"\"hi\"\"\"\n"
+    "\"two\nlines\",,\"carriage\rreturn\"\n"
+    "\xe2\x82\xac,\xf0\x9f\x98\x80,last\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  std::string pathRef = unittest::TempPath();
+
+  try
+  {
+    // same output as document
+    for (const bool hasCR : { false, true })
+    {
+      for (const bool autoQuote : { true, false })
+      {
+        // the linebreaks of a loaded document are detected from its data
+        std::string data;
+        for (const char ch : csv)
+        {
+          data += ((ch == '\n') && hasCR) ? "\r\n" : std::string(1, ch);
+        }
+
+        const rapidcsv::SeparatorParams separatorParams(',', false, hasCR, true, autoQuote);
+        std::istringstream sstream(data);
+        rapidcsv::Document doc(sstream, rapidcsv::LabelParams(-1, -1), separatorParams);
+        std::ostringstream ref;
+        doc.Save(ref);
+
+        unittest::ExpectEqual(std::string, WriteRows(doc, separatorParams), ref.str());
+        unittest::ExpectEqual(std::string, WriteRows(doc, separatorParams, rapidcsv::WriterParams(false, true, false, 1)),
+                              ref.str());
+      }
+    }
+
+    // custom separator and quote character
+    {
+      const rapidcsv::SeparatorParams separatorParams(';', false, false, false, true, '\'');
+      rapidcsv::Document doc("", rapidcsv::LabelParams(-1, -1), separatorParams);
+      doc.SetRow<std::string>(0, { "a;b", "it's", "plain" });
+      std::ostringstream ref;
+      doc.Save(ref);
+      unittest::ExpectEqual(std::string, ref.str(), "'a;b';'it''s';plain\n");
+      unittest::ExpectEqual(std::string, WriteRows(doc, separatorParams), ref.str());
+    }
+
+    // typed cells and rows
+    {
+      std::ostringstream stream;
+      rapidcsv::Writer writer(stream, rapidcsv::SeparatorParams(',', false, false));
+      writer.WriteRow<std::string>({ "name", "count", "ratio" });
+      writer.WriteCell<std::string>("first item");
+      writer.WriteCell(42);
+      writer.WriteCell(0.25);
+      writer.EndRow();
+      writer.WriteRow<int>({ -1, 2, 3 });
+      writer.WriteRow<std::string>({});
+      writer.Flush();
+      unittest::ExpectEqual(std::string, stream.str(), "name,count,ratio\n\"first item\",42,0.25\n-1,2,3\n\n");
+    }
+
+    // utf-16 and utf-8 with byte order mark, written in chunks
+    for (const bool littleEndian : { true, false })
+    {
+      std::istringstream sstream(csv);
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(-1, -1),
+                             rapidcsv::SeparatorParams(',', false, false, true));
+      {
+        rapidcsv::Writer writer(path, rapidcsv::SeparatorParams(',', false, false),
+                                rapidcsv::ConverterParams(), rapidcsv::WriterParams(true, littleEndian, false, 7));
+        for (size_t rowIdx = 0; rowIdx < doc.GetRowCount(); ++rowIdx)
+        {
+          writer.WriteRow(doc.GetRow<std::string>(rowIdx));
+        }
+      }
+
+      rapidcsv::Document utf16Doc(path, rapidcsv::LabelParams(-1, -1),
+                                  rapidcsv::SeparatorParams(',', false, false, true));
+      unittest::ExpectEqual(size_t, utf16Doc.GetRowCount(), doc.GetRowCount());
+      for (size_t rowIdx = 0; rowIdx < doc.GetRowCount(); ++rowIdx)
+      {
+        unittest::ExpectTrue(utf16Doc.GetRow<std::string>(rowIdx) == doc.GetRow<std::string>(rowIdx));
+      }
+
+      utf16Doc.Save(pathRef);
+      unittest::ExpectEqual(std::string, unittest::ReadFile(path), unittest::ReadFile(pathRef));
+    }
+
+    {
+      rapidcsv::Writer writer(path, rapidcsv::SeparatorParams(), rapidcsv::ConverterParams(),
+                              rapidcsv::WriterParams(false, true, true));
+      writer.WriteRow<std::string>({ "a", "b" });
+    }
+    unittest::ExpectEqual(std::string, unittest::ReadFile(path),
+                          std::string("\xef\xbb\xbf" "a,b") + (rapidcsv::SeparatorParams().mHasCR ? "\r\n" : "\n"));
+
+    ExpectException(rapidcsv::Writer("/nonexistent/rapidcsv.csv"), std::ios_base::failure);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(pathRef);
+
+  return rv;
+}
@@ -0,0 +1,123 @@
+// test123.cpp - label index lookups by name
+
+#include <map>
+#include <random>
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,A,\n"
+    "x,1,2,3,4\n"
+    "y,5,6,7,8\n"
+    "x,9,10,11,12\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0));
+
+    // the last of duplicate names is found
+    unittest::ExpectEqual(int, doc.GetColumnIdx("A"), 2);
+    unittest::ExpectEqual(int, doc.GetColumnIdx(std::string("B")), 1);
+    unittest::ExpectEqual(int, doc.GetColumnIdx(""), 3);
+    unittest::ExpectEqual(int, doc.GetColumnIdx("C"), -1);
+    unittest::ExpectEqual(int, doc.GetRowIdx("x"), 2);
+    unittest::ExpectEqual(int, doc.GetRowIdx(std::string("y")), 1);
+    unittest::ExpectEqual(int, doc.GetRowIdx("z"), -1);
+    unittest::ExpectEqual(int, doc.GetCell<int>("B", "y"), 6);
+
+    const char name[] = { 'B', 'x' };
+    unittest::ExpectEqual(int, doc.GetColumnIdx(std::string(name, 1)), 1);
+#if defined(RAPIDCSV_HAS_STRING_VIEW)
+    unittest::ExpectEqual(int, doc.GetColumnIdx(std::string_view(name, 1)), 1);
+    unittest::ExpectEqual(int, doc.GetRowIdx(std::string_view(name + 1, 1)), 2);
+#endif
+
+    // renaming
+    doc.SetColumnName(1, "C");
+    unittest::ExpectEqual(int, doc.GetColumnIdx("B"), -1);
+    unittest::ExpectEqual(int, doc.GetColumnIdx("C"), 1);
+    doc.SetRowName(1, "z");
+    unittest::ExpectEqual(int, doc.GetRowIdx("y"), -1);
+    unittest::ExpectEqual(int, doc.GetRowIdx("z"), 1);
+    unittest::ExpectEqual(int, doc.GetCell<int>("C", "z"), 6);
+
+    // many names
+    std::string largeCsv = "-,Value\n";
+    for (int i = 0; i < 100000; ++i)
+    {
+      largeCsv += "row" + std::to_string(i) + "," + std::to_string(i * 3) + "\n";
+    }
+    std::istringstream sstream(largeCsv);
+    rapidcsv::Document largeDoc(sstream, rapidcsv::LabelParams(0, 0));
+    for (int i = 0; i < 100000; i += 7)
+    {
+      const std::string rowName = "row" + std::to_string(i);
+      unittest::ExpectEqual(int, largeDoc.GetRowIdx(rowName.c_str()), i);
+      unittest::ExpectEqual(int, largeDoc.GetCell<int>("Value", rowName), i * 3);
+    }
+    unittest::ExpectEqual(int, largeDoc.GetRowIdx("row100000"), -1);
+
+    // random operations compared with std::map
+    rapidcsv::LabelIndex index;
+    std::map<std::string, size_t> ref;
+    std::mt19937 rng(123);
+    for (size_t op = 0; op < 200000; ++op)
+    {
+      const std::string key = std::to_string(rng() % 2000);
+      const unsigned action = rng() % 3;
+      if (action == 0)
+      {
+        index.Set(key, op);
+        ref[key] = op;
+      }
+      else if (action == 1)
+      {
+        index.Erase(key);
+        ref.erase(key);
+      }
+      else
+      {
+        size_t idx = 0;
+        const bool found = index.Find(key.data(), key.size(), idx);
+        unittest::ExpectEqual(bool, found, ref.count(key) == 1);
+        if (found)
+        {
+          unittest::ExpectEqual(size_t, idx, ref.at(key));
+        }
+      }
+
+      if ((op % 50000) == 0)
+      {
+        index.Reserve(op);
+      }
+    }
+
+    for (const std::pair<const std::string, size_t>& entry : ref)
+    {
+      size_t idx = 0;
+      unittest::ExpectTrue(index.Find(entry.first.data(), entry.first.size(), idx));
+      unittest::ExpectEqual(size_t, idx, entry.second);
+    }
+
+    index.Clear();
+    size_t idx = 0;
+    unittest::ExpectTrue(!index.Find("1", 1, idx));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
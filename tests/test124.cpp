@@ -0,0 +1,127 @@
+// test124.cpp - column and row references
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    for (const rapidcsv::StorageLayout layout :
+         { rapidcsv::StorageLayout::RowMajor, rapidcsv::StorageLayout::Buffer, rapidcsv::StorageLayout::ColumnMajor })
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                             rapidcsv::StorageParams(layout));
+
+      const rapidcsv::ColumnRef columnB = doc.GetColumnRef("B");
+      const rapidcsv::ColumnRef columnC = doc.GetColumnRef(2);
+      const rapidcsv::RowRef row2 = doc.GetRowRef("2");
+      unittest::ExpectTrue(doc.IsValid(columnB));
+      unittest::ExpectTrue(doc.IsValid(row2));
+      unittest::ExpectTrue(!doc.IsValid(rapidcsv::ColumnRef()));
+      unittest::ExpectTrue(!doc.IsValid(rapidcsv::RowRef()));
+      ExpectException(doc.GetColumnRef("D"), std::out_of_range);
+      ExpectException(doc.GetRowRef("3"), std::out_of_range);
+
+      unittest::ExpectEqual(int, doc.GetCell<int>(columnB, 0), 9);
+      unittest::ExpectEqual(int, doc.GetCell<int>(columnB, row2), 16);
+      unittest::ExpectEqual(int, doc.GetCell<int>(columnC, doc.GetRowRef(0)), 81);
+      unittest::ExpectEqual(int, doc.GetCellUnchecked<int>(columnC, 1), 256);
+      ExpectException(doc.GetCell<int>(columnB, 2), std::out_of_range);
+
+      // references are only valid for the document they were obtained from
+      rapidcsv::Document otherDoc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                  rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                                  rapidcsv::StorageParams(layout));
+      unittest::ExpectTrue(!otherDoc.IsValid(columnB));
+      unittest::ExpectTrue(!otherDoc.IsValid(row2));
+      ExpectExceptionMsg(otherDoc.GetCell<int>(columnB, 0), std::out_of_range, "column reference invalidated");
+      ExpectExceptionMsg(otherDoc.GetCell<int>(otherDoc.GetColumnRef("B"), row2), std::out_of_range,
+                         "row reference invalidated");
+
+      // references outliving their document are not accepted by a document at the same address
+      {
+        alignas(rapidcsv::Document) unsigned char storage[sizeof(rapidcsv::Document)];
+        rapidcsv::Document* storedDoc = new(storage) rapidcsv::Document(path, rapidcsv::LabelParams(0, 0));
+        const rapidcsv::ColumnRef storedColumnRef = storedDoc->GetColumnRef("B");
+        const rapidcsv::RowRef storedRowRef = storedDoc->GetRowRef("2");
+        storedDoc->~Document();
+        storedDoc = new(storage) rapidcsv::Document(path, rapidcsv::LabelParams(0, 0));
+        unittest::ExpectTrue(!storedDoc->IsValid(storedColumnRef));
+        unittest::ExpectTrue(!storedDoc->IsValid(storedRowRef));
+        storedDoc->~Document();
+      }
+
+      // failed insertion and removal keep references valid and storage unconverted
+      const rapidcsv::StorageStats storageStats = doc.GetStorageStats();
+      ExpectException(doc.RemoveRow(2), std::out_of_range);
+      ExpectException(doc.RemoveColumn(3), std::out_of_range);
+      ExpectException(doc.InsertColumn<int>(5, { 1, 2 }), std::out_of_range);
+      ExpectException(doc.RemoveRows(std::vector<size_t>({ 0, 2 })), std::out_of_range);
+      unittest::ExpectTrue(doc.IsValid(columnB));
+      unittest::ExpectTrue(doc.IsValid(row2));
+      unittest::ExpectEqual(size_t, doc.GetStorageStats().mSlabCount, storageStats.mSlabCount);
+      unittest::ExpectEqual(size_t, doc.GetStorageStats().mCellAllocations, storageStats.mCellAllocations);
+      unittest::ExpectEqual(int, doc.GetCell<int>(columnB, row2), 16);
+
+      // modification of cells and rows appended at the end keep references valid
+      doc.SetCell(columnB, 0, 10);
+      doc.SetCell(columnC, row2, 257);
+      doc.SetRow<int>(2, { 5, 25, 625 });
+      unittest::ExpectTrue(doc.IsValid(columnB));
+      unittest::ExpectTrue(doc.IsValid(row2));
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "1"), 10);
+      unittest::ExpectEqual(int, doc.GetCell<int>("C", "2"), 257);
+      unittest::ExpectEqual(int, doc.GetCell<int>(columnB, 2), 25);
+
+      // column insertion and removal invalidate column references only
+      doc.InsertColumn<int>(0, { 1, 2, 3 }, "Z");
+      unittest::ExpectTrue(!doc.IsValid(columnB));
+      unittest::ExpectTrue(doc.IsValid(row2));
+      ExpectExceptionMsg(doc.GetCell<int>(columnB, 0), std::out_of_range, "column reference invalidated");
+      ExpectExceptionMsg(doc.SetCell(columnB, row2, 0), std::out_of_range, "column reference invalidated");
+
+      const rapidcsv::ColumnRef columnBNew = doc.GetColumnRef("B");
+      unittest::ExpectEqual(int, doc.GetCell<int>(columnBNew, row2), 16);
+      doc.RemoveColumn("Z");
+      unittest::ExpectTrue(!doc.IsValid(columnBNew));
+
+      // row insertion and removal invalidate row references only
+      const rapidcsv::ColumnRef columnA = doc.GetColumnRef("A");
+      doc.RemoveRow("1");
+      unittest::ExpectTrue(!doc.IsValid(row2));
+      unittest::ExpectTrue(doc.IsValid(columnA));
+      ExpectExceptionMsg(doc.GetCell<int>(columnA, row2), std::out_of_range, "row reference invalidated");
+      unittest::ExpectEqual(int, doc.GetCell<int>(columnA, doc.GetRowRef("2")), 4);
+
+      const rapidcsv::RowRef row1 = doc.GetRowRef(0);
+      doc.InsertRow<int>(0, { 0, 0, 0 }, "0");
+      unittest::ExpectTrue(!doc.IsValid(row1));
+
+      // loading invalidates all references
+      doc.Load(path, rapidcsv::LabelParams(0, 0));
+      unittest::ExpectTrue(!doc.IsValid(columnA));
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+
+  return rv;
+}
@@ -0,0 +1,217 @@
+// test125.cpp - bulk row insertion and removal, label lookup after modifications
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+namespace
+{
+  void ExpectLabelsEqual(const rapidcsv::Document& pDoc, const rapidcsv::Document& pRefDoc)
+  {
+    unittest::ExpectEqual(size_t, pDoc.GetRowCount(), pRefDoc.GetRowCount());
+    for (size_t rowIdx = 0; rowIdx < pRefDoc.GetRowCount(); ++rowIdx)
+    {
+      const std::string rowName = pRefDoc.GetRowName(rowIdx);
+      unittest::ExpectEqual(std::string, pDoc.GetRowName(rowIdx), rowName);
+      unittest::ExpectEqual(int, pDoc.GetRowIdx(rowName), pRefDoc.GetRowIdx(rowName));
+      unittest::ExpectTrue(pDoc.GetRow<std::string>(rowIdx) == pRefDoc.GetRow<std::string>(rowIdx));
+    }
+
+    for (const std::string& columnName : pRefDoc.GetColumnNames())
+    {
+      unittest::ExpectEqual(int, pDoc.GetColumnIdx(columnName), pRefDoc.GetColumnIdx(columnName));
+    }
+  }
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B\n"
+    "r0,0,0\n"
+    "r1,1,10\n"
+    "r2,2,20\n"
+    "r3,3,30\n"
+    "r4,4,40\n"
+    "r5,5,50\n"
+  ;
+
+  try
+  {
+    // remove by index set, same result as removing one by one
+    {
+      std::istringstream sstream(csv);
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0));
+      rapidcsv::Document refDoc(doc);
+
+      doc.RemoveRows(std::vector<size_t>({ 4, 1, 2, 4 }));
+      refDoc.RemoveRow(4);
+      refDoc.RemoveRow(2);
+      refDoc.RemoveRow(1);
+      ExpectLabelsEqual(doc, refDoc);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r3"), 1);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r1"), -1);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "r5"), 50);
+
+      ExpectExceptionMsg(doc.RemoveRows(std::vector<size_t>({ 0, 3 })), std::out_of_range, "row out of range: 3");
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+    }
+
+    // remove by predicate
+    {
+      std::istringstream sstream(csv);
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0));
+      const std::vector<int> values = doc.GetColumn<int>("B");
+      doc.RemoveRows([&](const size_t pRowIdx) { return (values.at(pRowIdx) % 20) == 0; });
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+      unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 1, 3, 5 }));
+      unittest::ExpectEqual(int, doc.GetRowIdx("r5"), 2);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r4"), -1);
+      unittest::ExpectEqual(std::string, doc.GetColumnName(1), "B");
+
+      doc.RemoveRows([](const size_t) { return true; });
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 0);
+      unittest::ExpectEqual(int, doc.GetColumnIdx("B"), 1);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r1"), -1);
+    }
+
+    // insert rows, same result as inserting one by one
+    {
+      std::istringstream sstream(csv);
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0));
+      rapidcsv::Document refDoc(doc);
+
+      doc.InsertRows<int>(2, { { 7, 70 }, { 8, 80 }, {} }, { "n7", "", "n9" });
+      refDoc.InsertRow<int>(2, { 7, 70 }, "n7");
+      refDoc.InsertRow<int>(3, { 8, 80 });
+      refDoc.InsertRow<int>(4, {}, "n9");
+      ExpectLabelsEqual(doc, refDoc);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r2"), 5);
+      unittest::ExpectEqual(int, doc.GetCell<int>("A", "n7"), 7);
+
+      // beyond the end pads with empty rows
+      doc.InsertRows<std::string>(12, { { "x", "y" } }, { "last" });
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 13);
+      unittest::ExpectEqual(int, doc.GetRowIdx("last"), 12);
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "last"), "y");
+
+      rapidcsv::Document noNamesDoc("", rapidcsv::LabelParams(-1, -1));
+      ExpectExceptionMsg(noNamesDoc.InsertRows<int>(0, { { 1 } }, { "n" }), std::out_of_range,
+                         "row name column index < 0: -1");
+      noNamesDoc.InsertRows<int>(0, { { 1 } });
+    }
+
+    // interleaved single modifications and lookups
+    {
+      std::istringstream sstream(csv);
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0));
+      doc.RemoveRow(0);
+      doc.SetRowName(0, "first");
+      unittest::ExpectEqual(int, doc.GetRowIdx("first"), 0);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r1"), -1);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r2"), 1);
+
+      doc.RemoveColumn("A");
+      doc.InsertColumn<int>(1, { 1, 2, 3, 4, 5 }, "C");
+      doc.SetColumnName(0, "B2");
+      unittest::ExpectEqual(int, doc.GetColumnIdx("B2"), 0);
+      unittest::ExpectEqual(int, doc.GetColumnIdx("B"), -1);
+      unittest::ExpectEqual(int, doc.GetColumnIdx("C"), 1);
+      unittest::ExpectEqual(int, doc.GetColumnIdx("A"), -1);
+
+      for (int i = 0; i < 200; ++i)
+      {
+        doc.InsertRow<int>(0, { i, i }, "x" + std::to_string(i));
+      }
+      for (int i = 0; i < 100; ++i)
+      {
+        doc.RemoveRow(0);
+      }
+      unittest::ExpectEqual(int, doc.GetRowIdx("x99"), 0);
+      unittest::ExpectEqual(int, doc.GetRowIdx("x0"), 99);
+      unittest::ExpectEqual(int, doc.GetRowIdx("first"), 100);
+      unittest::ExpectEqual(int, doc.GetRowIdx("x100"), -1);
+    }
+
+    // single insertions and removals, including duplicate names, match a reloaded document
+    {
+      std::istringstream sstream("-,A,B,A\nr0,1,2,3\nr1,4,5,6\nr0,7,8,9\nr2,10,11,12\n");
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0));
+      const auto expectReloadEqual = [&]()
+      {
+        std::ostringstream ostream;
+        doc.Save(ostream);
+        std::istringstream reloadStream(ostream.str());
+        const rapidcsv::Document refDoc(reloadStream, rapidcsv::LabelParams(0, 0));
+        ExpectLabelsEqual(doc, refDoc);
+      };
+
+      expectReloadEqual();
+      unittest::ExpectEqual(int, doc.GetRowIdx("r0"), 2);
+      unittest::ExpectEqual(int, doc.GetColumnIdx("A"), 2);
+
+      doc.RemoveRow(2);
+      expectReloadEqual();
+      unittest::ExpectEqual(int, doc.GetRowIdx("r0"), 0);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r2"), 2);
+
+      doc.InsertRow<int>(1, { 0, 0, 0 }, "r2");
+      expectReloadEqual();
+      unittest::ExpectEqual(int, doc.GetRowIdx("r2"), 3);
+
+      doc.InsertRow<int>(4, { 1, 1, 1 }, "r0");
+      doc.InsertRow<int>(0, { 2, 2, 2 }, "r3");
+      expectReloadEqual();
+      unittest::ExpectEqual(int, doc.GetRowIdx("r0"), 5);
+
+      doc.RemoveRow(5);
+      doc.RemoveRow(0);
+      expectReloadEqual();
+      unittest::ExpectEqual(int, doc.GetRowIdx("r0"), 0);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r3"), -1);
+
+      doc.SetRowName(3, "r1");
+      expectReloadEqual();
+      unittest::ExpectEqual(int, doc.GetRowIdx("r1"), 3);
+      unittest::ExpectEqual(int, doc.GetRowIdx("r2"), 1);
+
+      doc.RemoveColumn(2);
+      expectReloadEqual();
+      unittest::ExpectEqual(int, doc.GetColumnIdx("A"), 0);
+
+      doc.InsertColumn<int>(1, { 5, 5, 5, 5 }, "A");
+      doc.InsertColumn<int>(0, { 6, 6, 6, 6 }, "C");
+      doc.InsertColumn<int>(4, { 7, 7, 7, 7 }, "B");
+      expectReloadEqual();
+      unittest::ExpectEqual(int, doc.GetColumnIdx("A"), 2);
+      unittest::ExpectEqual(int, doc.GetColumnIdx("B"), 4);
+
+      doc.RemoveColumn(2);
+      doc.SetColumnName(0, "A");
+      expectReloadEqual();
+      unittest::ExpectEqual(int, doc.GetColumnIdx("A"), 1);
+      unittest::ExpectEqual(int, doc.GetColumnIdx("C"), -1);
+
+      doc.RemoveColumn(1);
+      expectReloadEqual();
+      unittest::ExpectEqual(int, doc.GetColumnIdx("A"), 0);
+    }
+
+    // references invalidated by bulk modifications
+    {
+      std::istringstream sstream(csv);
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0));
+      const rapidcsv::RowRef rowRef = doc.GetRowRef("r3");
+      doc.RemoveRows(std::vector<size_t>());
+      unittest::ExpectTrue(!doc.IsValid(rowRef));
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,123 @@
+// test126.cpp - typed column cache and its invalidation
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+  ;
+
+  try
+  {
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                           rapidcsv::StorageParams(rapidcsv::StorageLayout::RowMajor, true /* pColumnCache */));
+
+    // hits per column and type
+    unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 3, 4 }));
+    unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 3, 4 }));
+    unittest::ExpectTrue(doc.GetColumn<double>(0) == std::vector<double>({ 3, 4 }));
+    unittest::ExpectTrue(doc.GetColumn<std::string>("A") == std::vector<std::string>({ "3", "4" }));
+    unittest::ExpectTrue(doc.GetColumn<int>("B") == std::vector<int>({ 9, 16 }));
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 81, 256 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheHits(), 1);
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheMisses(), 5);
+
+    // conversion functions bypass the cache
+    doc.GetColumn<int>(0, [](const std::string& pStr, int& pVal) { pVal = std::stoi(pStr) * 2; });
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheMisses(), 5);
+
+    // modifying a cell only invalidates its column
+    doc.SetCell<int>("A", "2", 5);
+    unittest::ExpectTrue(doc.GetColumn<int>("B") == std::vector<int>({ 9, 16 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheHits(), 2);
+    unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 3, 5 }));
+    unittest::ExpectTrue(doc.GetColumn<double>("A") == std::vector<double>({ 3, 5 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheMisses(), 7);
+
+    doc.SetColumn<int>("B", { 10, 20 });
+    unittest::ExpectTrue(doc.GetColumn<int>("B") == std::vector<int>({ 10, 20 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheMisses(), 8);
+
+    // inserting and removing columns shift cached columns
+    doc.InsertColumn<int>(0, { 1, 2 }, "Z");
+    unittest::ExpectTrue(doc.GetColumn<int>("Z") == std::vector<int>({ 1, 2 }));
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 81, 256 }));
+    unittest::ExpectTrue(doc.GetColumn<int>(1) == std::vector<int>({ 3, 5 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheMisses(), 9);
+
+    doc.RemoveColumn("A");
+    unittest::ExpectTrue(doc.GetColumn<int>(1) == std::vector<int>({ 10, 20 }));
+    unittest::ExpectTrue(doc.GetColumn<int>(2) == std::vector<int>({ 81, 256 }));
+    unittest::ExpectTrue(doc.GetColumn<int>(0) == std::vector<int>({ 1, 2 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheMisses(), 9);
+
+    // row modifications invalidate all columns
+    doc.SetRow<int>("1", { 7, 8, 9 });
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 9, 256 }));
+    doc.InsertRow<int>(2, { 0, 0, 0 }, "3");
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 9, 256, 0 }));
+    doc.RemoveRow("1");
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 256, 0 }));
+    doc.RemoveRows(std::vector<size_t>({ 1 }));
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 256 }));
+    doc.InsertRows<int>(1, { { 1, 1, 1 } });
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 256, 1 }));
+
+    // cells appended beyond the last row extend all columns
+    const size_t missCount = doc.GetColumnCacheMisses();
+    unittest::ExpectTrue(doc.GetColumn<std::string>("Z") == std::vector<std::string>({ "2", "1" }));
+    doc.SetCell<int>("C", 2, 5);
+    unittest::ExpectTrue(doc.GetColumn<std::string>("Z") == std::vector<std::string>({ "2", "1", "" }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheMisses(), missCount + 2);
+
+    // row names are not part of columns
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 256, 1, 5 }));
+    doc.SetRowName(0, "first");
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 256, 1, 5 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheMisses(), missCount + 3);
+
+    // clearing and reloading
+    doc.ClearColumnCache();
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 256, 1, 5 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheMisses(), missCount + 4);
+
+    std::istringstream reloadStream(csv);
+    doc.Load(reloadStream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(), rapidcsv::ConverterParams(),
+             rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+             rapidcsv::StorageParams(rapidcsv::StorageLayout::ColumnMajor, true));
+    unittest::ExpectTrue(doc.GetColumn<int>("C") == std::vector<int>({ 81, 256 }));
+    unittest::ExpectEqual(size_t, doc.GetColumnCacheMisses(), missCount + 5);
+    doc.SetCell<int>("C", "1", 1);
+    doc.InsertColumn<int>(0, { 0, 0 });
+    unittest::ExpectTrue(doc.GetColumn<int>(3) == std::vector<int>({ 1, 256 }));
+
+    // failed conversions are not cached
+    ExpectException(doc.GetColumn<int>(99), std::out_of_range);
+    doc.SetCell<std::string>(1, 0, "x");
+    ExpectException(doc.GetColumn<int>(1), std::invalid_argument);
+    ExpectException(doc.GetColumn<int>(1), std::invalid_argument);
+
+    // disabled by default
+    std::istringstream defaultStream(csv);
+    rapidcsv::Document defaultDoc(defaultStream, rapidcsv::LabelParams(0, 0));
+    defaultDoc.GetColumn<int>("A");
+    defaultDoc.GetColumn<int>("A");
+    unittest::ExpectEqual(size_t, defaultDoc.GetColumnCacheHits(), 0);
+    unittest::ExpectEqual(size_t, defaultDoc.GetColumnCacheMisses(), 0);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
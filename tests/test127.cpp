@@ -0,0 +1,89 @@
+// test127.cpp - get columns and rows into caller-provided vectors and arrays
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B,C\n"
+    "1,3,9,81\n"
+    "2,4,16,256\n"
+  ;
+
+  try
+  {
+    for (const bool columnCache : { false, true })
+    {
+      std::istringstream sstream(csv);
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                             rapidcsv::StorageParams(rapidcsv::StorageLayout::RowMajor, columnCache));
+
+      // vectors are replaced and keep their capacity
+      std::vector<int> values = { 1, 2, 3, 4, 5, 6, 7, 8 };
+      const int* data = values.data();
+      doc.GetColumn<int>(1, values);
+      unittest::ExpectTrue(values == std::vector<int>({ 9, 16 }));
+      unittest::ExpectTrue(values.data() == data);
+      doc.GetColumn<int>("C", values);
+      unittest::ExpectTrue(values == std::vector<int>({ 81, 256 }));
+      doc.GetRow<int>(0, values);
+      unittest::ExpectTrue(values == std::vector<int>({ 3, 9, 81 }));
+      doc.GetRow<int>("2", values);
+      unittest::ExpectTrue(values == std::vector<int>({ 4, 16, 256 }));
+      unittest::ExpectTrue(values.data() == data);
+
+      std::vector<std::string> strings;
+      doc.GetRow<std::string>(1, strings);
+      unittest::ExpectTrue(strings == doc.GetRow<std::string>(1));
+
+      // arrays
+      double array[4] = { -1, -1, -1, -1 };
+      unittest::ExpectEqual(size_t, doc.GetColumn<double>(0, array, 4), 2);
+      unittest::ExpectEqual(double, array[0], 3);
+      unittest::ExpectEqual(double, array[1], 4);
+      unittest::ExpectEqual(double, array[2], -1);
+      unittest::ExpectEqual(size_t, doc.GetColumn<double>("B", array, 2), 2);
+      unittest::ExpectEqual(double, array[1], 16);
+      unittest::ExpectEqual(size_t, doc.GetRow<double>(1, array, 3), 3);
+      unittest::ExpectEqual(double, array[2], 256);
+      unittest::ExpectEqual(size_t, doc.GetRow<double>("1", array, 4), 3);
+      unittest::ExpectEqual(double, array[0], 3);
+      unittest::ExpectEqual(double, array[3], -1);
+
+      ExpectExceptionMsg(doc.GetColumn<double>(0, array, 1), std::out_of_range, "output size 1 < required size 2");
+      ExpectExceptionMsg(doc.GetRow<double>(0, array, 2), std::out_of_range, "output size 2 < required size 3");
+      ExpectException(doc.GetColumn<int>("D", values), std::out_of_range);
+      ExpectException(doc.GetRow<double>("3", array, 4), std::out_of_range);
+      ExpectException(doc.GetColumn<int>(3, values), std::out_of_range);
+    }
+
+    // empty document
+    rapidcsv::Document emptyDoc("", rapidcsv::LabelParams(-1, -1));
+    std::vector<int> values = { 1 };
+    unittest::ExpectEqual(size_t, emptyDoc.GetColumn<int>(0, values.data(), 0), 0);
+    emptyDoc.GetColumn<int>(0, values);
+    unittest::ExpectTrue(values.empty());
+
+    // reader
+    std::istringstream sstream(csv);
+    rapidcsv::Reader reader(sstream, rapidcsv::LabelParams(0, 0));
+    std::vector<long> row = { 0, 0, 0, 0, 0 };
+    unittest::ExpectTrue(reader.ReadRow());
+    reader.GetRow<long>(row);
+    unittest::ExpectTrue(row == std::vector<long>({ 3, 9, 81 }));
+    unittest::ExpectTrue(reader.ReadRow());
+    reader.GetRow<long>(row);
+    unittest::ExpectTrue(row == std::vector<long>({ 4, 16, 256 }));
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
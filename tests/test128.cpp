@@ -0,0 +1,109 @@
+// test128.cpp - set and insert moved rows and columns
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+namespace
+{
+  // strings longer than the small string buffer of common implementations
+  std::string Long(const std::string& pStr)
+  {
+    return pStr + std::string(32, '.');
+  }
+
+  bool IsMovedFrom(const std::vector<std::string>& pStrs)
+  {
+    for (const std::string& str : pStrs)
+    {
+      if (!str.empty())
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B\n"
+    "1,3,9\n"
+    "2,4,16\n"
+  ;
+
+  try
+  {
+    for (const rapidcsv::StorageLayout layout : { rapidcsv::StorageLayout::RowMajor,
+                                                  rapidcsv::StorageLayout::Buffer,
+                                                  rapidcsv::StorageLayout::ColumnMajor })
+    {
+      std::istringstream sstream(csv);
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                             rapidcsv::StorageParams(layout));
+
+      std::vector<std::string> column = { Long("a"), Long("b") };
+      doc.SetColumn(1, std::move(column));
+      unittest::ExpectTrue(IsMovedFrom(column));
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "2"), Long("b"));
+
+      column = { Long("c"), Long("d"), Long("e") };
+      doc.SetColumn("A", std::move(column));
+      unittest::ExpectTrue(IsMovedFrom(column));
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 2), Long("e"));
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(1, 2), "");
+
+      column = { Long("f"), Long("g"), "" };
+      doc.InsertColumn(1, std::move(column), "C");
+      unittest::ExpectTrue(IsMovedFrom(column));
+      unittest::ExpectTrue(doc.GetColumn<std::string>("C") == std::vector<std::string>({ Long("f"), Long("g"), "" }));
+      unittest::ExpectEqual(std::string, doc.GetColumnName(2), "B");
+
+      std::vector<std::string> row = { Long("h"), Long("i"), Long("j") };
+      doc.SetRow(1, std::move(row));
+      unittest::ExpectTrue(IsMovedFrom(row));
+      unittest::ExpectTrue(doc.GetRow<std::string>("2") == std::vector<std::string>({ Long("h"), Long("i"), Long("j") }));
+
+      row = { Long("k") };
+      doc.SetRow("1", std::move(row));
+      unittest::ExpectTrue(IsMovedFrom(row));
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("A", "1"), Long("k"));
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("C", "1"), Long("f"));
+
+      row = { Long("l"), Long("m"), "" };
+      doc.InsertRow(0, std::move(row), "0");
+      unittest::ExpectTrue(IsMovedFrom(row));
+      unittest::ExpectTrue(doc.GetRow<std::string>("0") == std::vector<std::string>({ Long("l"), Long("m"), "" }));
+      unittest::ExpectEqual(int, doc.GetRowIdx("1"), 1);
+
+      // other data types are converted as for lvalues
+      doc.InsertRow(4, std::vector<int>({ 1, 2, 3 }));
+      doc.SetColumn(2, std::vector<double>({ 0.5 }));
+      unittest::ExpectTrue(doc.GetRow<int>(4) == std::vector<int>({ 1, 2, 3 }));
+      unittest::ExpectEqual(double, doc.GetCell<double>(2, 0), 0.5);
+
+      // lvalues are copied
+      std::vector<std::string> copied = { Long("n"), Long("o"), Long("p"), Long("q"), Long("r") };
+      doc.InsertColumn(0, copied);
+      copied.resize(4);
+      doc.SetRow(1, copied);
+      unittest::ExpectEqual(std::string, copied.at(0), Long("n"));
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 1), Long("n"));
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>(0, 4), Long("r"));
+
+      ExpectException(doc.SetColumn("X", std::vector<std::string>()), std::out_of_range);
+      ExpectException(doc.SetRow("X", std::vector<std::string>()), std::out_of_range);
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,109 @@
+// test129.cpp - row count hints and reserving rows and columns
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv = "-,A,B,C\n";
+  for (int i = 0; i < 1000; ++i)
+  {
+    csv += std::to_string(i) + "," + std::to_string(i * 2) + ",\"x\n" + std::to_string(i) + "\"," +
+           std::to_string(i * 3) + "\n";
+  }
+
+  try
+  {
+    const rapidcsv::SeparatorParams separatorParams(',', false, rapidcsv::sPlatformHasCR, true /* pQuotedLinebreaks */);
+    for (const rapidcsv::StorageLayout layout : { rapidcsv::StorageLayout::RowMajor,
+                                                  rapidcsv::StorageLayout::Buffer,
+                                                  rapidcsv::StorageLayout::ColumnMajor })
+    {
+      // estimated, underestimated and overestimated row counts yield the same data
+      for (const size_t rowCountHint : std::vector<size_t>({ 0, 1, 1000, 100000 }))
+      {
+        std::istringstream sstream(csv);
+        rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), separatorParams,
+                               rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                               rapidcsv::LoadParams(false, 1, rowCountHint), rapidcsv::StorageParams(layout));
+        unittest::ExpectEqual(size_t, doc.GetRowCount(), 1000);
+        unittest::ExpectEqual(size_t, doc.GetColumnCount(), 3);
+        unittest::ExpectEqual(int, doc.GetCell<int>("C", "999"), 2997);
+        unittest::ExpectEqual(std::string, doc.GetCell<std::string>("B", "500"), "x\n500");
+
+        // concurrent parsing reserves storage for all data up front
+        std::istringstream concurrentStream(csv);
+        rapidcsv::Document concurrentDoc(concurrentStream, rapidcsv::LabelParams(0, 0), separatorParams,
+                                         rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                         rapidcsv::LoadParams(false, 2, rowCountHint), rapidcsv::StorageParams(layout));
+        unittest::ExpectTrue(concurrentDoc.GetColumn<int>("A") == doc.GetColumn<int>("A"));
+        unittest::ExpectTrue(concurrentDoc.GetRow<std::string>(999) == doc.GetRow<std::string>(999));
+      }
+
+      // reserving does not change the data
+      std::istringstream sstream("-,A,B\n1,3,9\n2,4,16\n");
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                             rapidcsv::StorageParams(layout));
+      doc.ReserveRows(100);
+      doc.ReserveColumns(10);
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 2);
+      unittest::ExpectEqual(size_t, doc.GetColumnCount(), 2);
+
+      for (int i = 3; i < 100; ++i)
+      {
+        doc.InsertRow<int>(doc.GetRowCount(), { i + 1, (i + 1) * (i + 1) }, std::to_string(i));
+      }
+      doc.InsertColumn<int>(2, std::vector<int>(99, 7), "C");
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 99);
+      unittest::ExpectEqual(int, doc.GetCell<int>("B", "99"), 10000);
+      unittest::ExpectEqual(int, doc.GetCell<int>("C", "1"), 7);
+      unittest::ExpectEqual(std::string, doc.GetColumnName(1), "B");
+    }
+
+    // cell data is reserved for the rows and columns stored only
+    std::string largeCsv = "A,B,C\n";
+    for (int i = 0; i < 100000; ++i)
+    {
+      largeCsv += std::to_string(i) + ",abcdefghij,klmnopqrst\n";
+    }
+    const size_t maxCellBytes = 1024 * 1024 + 64 * 1024;
+    for (const rapidcsv::LoadParams& loadParams : { rapidcsv::LoadParams(false, 1, 0, {}, {}, 0, 100),
+                                                    rapidcsv::LoadParams(false, 1, 0, {}, {}, 99900),
+                                                    rapidcsv::LoadParams(false, 1, 0, { 0 }) })
+    {
+      std::istringstream sstream(largeCsv);
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), loadParams,
+                             rapidcsv::StorageParams(rapidcsv::StorageLayout::Buffer));
+      unittest::ExpectTrue(doc.GetStorageStats().mSlabBytes < maxCellBytes);
+    }
+
+    std::istringstream fullStream(largeCsv);
+    rapidcsv::Document fullDoc(fullStream, rapidcsv::LabelParams(), rapidcsv::SeparatorParams(),
+                               rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                               rapidcsv::StorageParams(rapidcsv::StorageLayout::Buffer));
+    unittest::ExpectEqual(size_t, fullDoc.GetRowCount(), 100000);
+    unittest::ExpectEqual(size_t, fullDoc.GetStorageStats().mSlabCount, 1);
+    unittest::ExpectTrue(fullDoc.GetStorageStats().mSlabBytes >= fullDoc.GetStorageStats().mSlabUsedBytes);
+
+    // empty data and documents without labels
+    rapidcsv::Document emptyDoc("", rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                                rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                rapidcsv::LoadParams(false, 1, 10));
+    emptyDoc.ReserveRows(10);
+    emptyDoc.ReserveColumns(10);
+    unittest::ExpectEqual(size_t, emptyDoc.GetRowCount(), 0);
+    emptyDoc.SetCell<int>(1, 1, 5);
+    unittest::ExpectEqual(int, emptyDoc.GetCell<int>(1, 1), 5);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,81 @@
+// test130.cpp - cell storage in slabs and storage statistics
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B\n"
+    "1,3,9\n"
+    "2,4,16\n"
+  ;
+
+  try
+  {
+    // cells fill a slab reserved for the loaded data
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                           rapidcsv::StorageParams(rapidcsv::StorageLayout::Buffer));
+    rapidcsv::StorageStats stats = doc.GetStorageStats();
+    unittest::ExpectEqual(size_t, stats.mSlabCount, 1);
+    unittest::ExpectTrue(stats.mSlabBytes >= csv.size());
+    unittest::ExpectEqual(size_t, stats.mSlabUsedBytes, 10);
+    unittest::ExpectEqual(size_t, stats.mCellAllocations, 0);
+    unittest::ExpectEqual(int, doc.GetCell<int>("B", "2"), 16);
+
+    // modification converts cells to strings, which fit the string object if short
+    const std::string longCell(100, 'x');
+    doc.SetCell<std::string>("A", "1", longCell);
+    stats = doc.GetStorageStats();
+    unittest::ExpectEqual(size_t, stats.mSlabCount, 0);
+    unittest::ExpectEqual(size_t, stats.mSlabBytes, 0);
+    unittest::ExpectEqual(size_t, stats.mCellAllocations, 1);
+
+    // cells not fitting the last slab start a new one
+    rapidcsv::CellBuffer cellBuffer;
+    cellBuffer.Reserve(4);
+    cellBuffer.AppendRow({ "ab", "", "c" });
+    unittest::ExpectEqual(size_t, cellBuffer.GetSlabCount(), 1);
+    cellBuffer.AppendRow({ "de", longCell, "" });
+    cellBuffer.AppendRow({ "f" });
+    unittest::ExpectEqual(size_t, cellBuffer.GetSlabCount(), 2);
+    unittest::ExpectEqual(size_t, cellBuffer.GetCellBytes(), 106);
+
+    std::string cell;
+    const std::vector<std::vector<std::string>> rows = { { "ab", "", "c" }, { "de", longCell, "" }, { "f" } };
+    for (size_t rowIdx = 0; rowIdx < rows.size(); ++rowIdx)
+    {
+      unittest::ExpectEqual(size_t, cellBuffer.GetRowSize(rowIdx), rows[rowIdx].size());
+      for (size_t columnIdx = 0; columnIdx < rows[rowIdx].size(); ++columnIdx)
+      {
+        cellBuffer.GetCell(rowIdx, columnIdx, cell);
+        unittest::ExpectEqual(std::string, cell, rows[rowIdx][columnIdx]);
+      }
+    }
+
+    cellBuffer.Clear();
+    unittest::ExpectEqual(size_t, cellBuffer.GetSlabCount(), 0);
+    unittest::ExpectEqual(size_t, cellBuffer.GetRowCount(), 0);
+
+    // column-major cells
+    std::istringstream columnStream(csv);
+    rapidcsv::Document columnDoc(columnStream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                 rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                                 rapidcsv::StorageParams(rapidcsv::StorageLayout::ColumnMajor));
+    columnDoc.SetColumn<std::string>("B", { longCell, longCell });
+    unittest::ExpectEqual(size_t, columnDoc.GetStorageStats().mCellAllocations, 2);
+    columnDoc.Clear();
+    unittest::ExpectEqual(size_t, columnDoc.GetStorageStats().mCellAllocations, 0);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,92 @@
+// test131.cpp - dictionary encoded columns
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv = "-,Ticker,Price,Exchange\n";
+  const std::vector<std::string> tickers = { "MSFT", "AAPL", "GOOG" };
+  for (int i = 0; i < 100; ++i)
+  {
+    csv += std::to_string(i) + "," + tickers[static_cast<size_t>(i) % 3] + "," + std::to_string(i) + ".5," +
+           ((i < 99) ? "NYSE" : "") + "\n";
+  }
+
+  try
+  {
+    // encoded by name, or automatically by cardinality
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                           rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                           rapidcsv::StorageParams(rapidcsv::StorageLayout::ColumnMajor, false, { "Ticker" }, 2));
+    unittest::ExpectTrue(doc.IsColumnDictionaryEncoded("Ticker"));
+    unittest::ExpectTrue(!doc.IsColumnDictionaryEncoded("Price"));
+    unittest::ExpectTrue(doc.IsColumnDictionaryEncoded(2));
+
+    unittest::ExpectTrue(doc.GetColumnDictionary("Ticker") == tickers);
+    const std::vector<uint32_t>& codes = doc.GetColumnCodes("Ticker");
+    unittest::ExpectEqual(size_t, codes.size(), 100);
+    unittest::ExpectEqual(uint32_t, codes.at(4), 1);
+    unittest::ExpectTrue(doc.GetColumnDictionary(2) == std::vector<std::string>({ "NYSE", "" }));
+    unittest::ExpectEqual(uint32_t, doc.GetColumnCodes(2).at(99), 1);
+
+    // cells are accessed as usual
+    unittest::ExpectEqual(std::string, doc.GetColumnName(0), "Ticker");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("Ticker", "5"), "GOOG");
+    unittest::ExpectEqual(std::string, doc.GetRow<std::string>("98").at(0), "GOOG");
+    unittest::ExpectEqual(size_t, doc.GetColumn<std::string>("Exchange").size(), 100);
+
+    // label modification keeps, and cell modification decodes, the column
+    doc.SetColumnName(0, "Symbol");
+    unittest::ExpectTrue(doc.IsColumnDictionaryEncoded("Symbol"));
+    doc.SetCell<std::string>("Symbol", "1", "IBM");
+    unittest::ExpectTrue(!doc.IsColumnDictionaryEncoded("Symbol"));
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("Symbol", "1"), "IBM");
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("Symbol", "2"), "GOOG");
+    ExpectExceptionMsg(doc.GetColumnCodes("Symbol"), std::out_of_range, "column not dictionary encoded: 0");
+
+    // column insertion and removal keep other columns encoded
+    doc.InsertColumn<int>(0, std::vector<int>(100, 1), "One");
+    unittest::ExpectTrue(doc.IsColumnDictionaryEncoded("Exchange"));
+    doc.RemoveColumn("Price");
+    unittest::ExpectTrue(doc.IsColumnDictionaryEncoded("Exchange"));
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("Exchange", "50"), "NYSE");
+
+    // row modification converts to row-major layout
+    doc.RemoveRow(0);
+    unittest::ExpectTrue(!doc.IsColumnDictionaryEncoded("Exchange"));
+    unittest::ExpectEqual(std::string, doc.GetCell<std::string>("Exchange", "50"), "NYSE");
+
+    // other layouts, and high cardinality, are not encoded
+    std::istringstream rowStream(csv);
+    rapidcsv::Document rowDoc(rowStream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                              rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                              rapidcsv::StorageParams(rapidcsv::StorageLayout::RowMajor, false, { "Ticker" }, 1000));
+    unittest::ExpectTrue(!rowDoc.IsColumnDictionaryEncoded("Ticker"));
+    ExpectException(rowDoc.GetColumnDictionary(0), std::out_of_range);
+
+    std::istringstream columnStream(csv);
+    rapidcsv::Document columnDoc(columnStream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                 rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(),
+                                 rapidcsv::StorageParams(rapidcsv::StorageLayout::ColumnMajor, false, {}, 1000));
+    unittest::ExpectTrue(columnDoc.IsColumnDictionaryEncoded("Ticker"));
+    unittest::ExpectTrue(!columnDoc.IsColumnDictionaryEncoded("Price"));
+
+    std::istringstream missingStream(csv);
+    ExpectExceptionMsg(rapidcsv::Document(missingStream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                          rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                          rapidcsv::LoadParams(),
+                                          rapidcsv::StorageParams(rapidcsv::StorageLayout::ColumnMajor, false, { "X" })),
+                       std::out_of_range, "column not found: X");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
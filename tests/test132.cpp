@@ -0,0 +1,105 @@
+// test132.cpp - load selected columns only
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "# comment\n"
+    "-,A,B,C,D\n"
+    "1,3,\"x,y\",81,a\n"
+    "\n"
+    "2,4,16,256\n"
+    "3,5\n"
+  ;
+
+  try
+  {
+    for (const size_t threadCount : std::vector<size_t>({ 1, 2 }))
+    {
+      for (const rapidcsv::StorageLayout layout : { rapidcsv::StorageLayout::RowMajor,
+                                                    rapidcsv::StorageLayout::Buffer,
+                                                    rapidcsv::StorageLayout::ColumnMajor })
+      {
+        // by name, in file order
+        std::istringstream sstream(csv);
+        rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                               rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(true, '#', true),
+                               rapidcsv::LoadParams(false, threadCount, 0, {}, { "D", "A" }),
+                               rapidcsv::StorageParams(layout));
+        unittest::ExpectEqual(size_t, doc.GetColumnCount(), 2);
+        unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+        unittest::ExpectTrue(doc.GetColumnNames() == std::vector<std::string>({ "A", "D" }));
+        unittest::ExpectEqual(int, doc.GetColumnIdx("D"), 1);
+        unittest::ExpectEqual(int, doc.GetColumnIdx("B"), -1);
+        unittest::ExpectTrue(doc.GetColumn<int>("A") == std::vector<int>({ 3, 4, 5 }));
+        unittest::ExpectEqual(std::string, doc.GetCell<std::string>("D", "1"), "a");
+        unittest::ExpectEqual(std::string, doc.GetRowName(2), "3");
+        unittest::ExpectEqual(size_t, doc.GetRow<std::string>("3").size(), 1);
+
+        // by index and name combined
+        std::istringstream indexStream(csv);
+        rapidcsv::Document indexDoc(indexStream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                    rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(true, '#', true),
+                                    rapidcsv::LoadParams(false, threadCount, 0, { 1, 2 }, { "C" }),
+                                    rapidcsv::StorageParams(layout));
+        unittest::ExpectTrue(indexDoc.GetColumnNames() == std::vector<std::string>({ "B", "C" }));
+        unittest::ExpectTrue(indexDoc.GetRow<std::string>("1") == std::vector<std::string>({ "x,y", "81" }));
+        unittest::ExpectEqual(std::string, indexDoc.GetCell<std::string>("C", "2"), "256");
+        unittest::ExpectEqual(size_t, indexDoc.GetRow<std::string>("3").size(), 0);
+      }
+    }
+
+    // concurrent parsing of data split into chunks
+    std::string largeCsv = "-,A,B,C\n";
+    for (int i = 0; i < 40000; ++i)
+    {
+      largeCsv += std::to_string(i) + "," + std::to_string(i * 2) + ",\"b\n" + std::to_string(i) + "\",c\n";
+    }
+    for (const size_t threadCount : std::vector<size_t>({ 1, 4 }))
+    {
+      std::istringstream largeStream(largeCsv);
+      rapidcsv::Document largeDoc(largeStream, rapidcsv::LabelParams(0, 0),
+                                  rapidcsv::SeparatorParams(',', false, rapidcsv::sPlatformHasCR, true),
+                                  rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                  rapidcsv::LoadParams(false, threadCount, 0, {}, { "B" }));
+      unittest::ExpectEqual(size_t, largeDoc.GetRowCount(), 40000);
+      unittest::ExpectEqual(size_t, largeDoc.GetColumnCount(), 1);
+      unittest::ExpectEqual(std::string, largeDoc.GetCell<std::string>("B", "39999"), "b\n39999");
+    }
+
+    // without labels
+    rapidcsv::Document noLabelDoc("", rapidcsv::LabelParams(-1, -1));
+    std::istringstream noLabelStream("1,2,3\n4,5,6\n");
+    noLabelDoc.Load(noLabelStream, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                    rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(), rapidcsv::LoadParams(false, 1, 0, { 2, 0 }));
+    unittest::ExpectTrue(noLabelDoc.GetRow<int>(1) == std::vector<int>({ 4, 6 }));
+
+    // names missing or requiring labels
+    std::istringstream missingStream(csv);
+    ExpectExceptionMsg(rapidcsv::Document(missingStream, rapidcsv::LabelParams(1, 0), rapidcsv::SeparatorParams(),
+                                          rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                          rapidcsv::LoadParams(false, 1, 0, {}, { "A", "-" })),
+                       std::out_of_range, "column not found: -");
+    std::istringstream shortStream("-,A\n");
+    ExpectExceptionMsg(rapidcsv::Document(shortStream, rapidcsv::LabelParams(1, 0), rapidcsv::SeparatorParams(),
+                                          rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                          rapidcsv::LoadParams(false, 1, 0, {}, { "A" })),
+                       std::out_of_range, "column not found: A");
+    std::istringstream noNameStream(csv);
+    ExpectExceptionMsg(rapidcsv::Document(noNameStream, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(),
+                                          rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                          rapidcsv::LoadParams(false, 1, 0, {}, { "A" })),
+                       std::out_of_range, "column name row index < 0: -1");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,91 @@
+// test133.cpp - load range of rows and filtered rows
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv = "Date,Value,Note\n";
+  for (int i = 1; i <= 9; ++i)
+  {
+    csv += "2024-01-0" + std::to_string(i) + "," + std::to_string(i * 10) + ",n" + std::to_string(i) + "\n";
+  }
+
+  try
+  {
+    for (const rapidcsv::StorageLayout layout : { rapidcsv::StorageLayout::RowMajor,
+                                                  rapidcsv::StorageLayout::Buffer,
+                                                  rapidcsv::StorageLayout::ColumnMajor })
+    {
+      // range of rows
+      std::istringstream sstream(csv);
+      rapidcsv::Document doc(sstream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                             rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                             rapidcsv::LoadParams(false, 1, 0, {}, {}, 2, 3),
+                             rapidcsv::StorageParams(layout));
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 3);
+      unittest::ExpectTrue(doc.GetColumnNames() == std::vector<std::string>({ "Value", "Note" }));
+      unittest::ExpectTrue(doc.GetColumn<int>("Value") == std::vector<int>({ 30, 40, 50 }));
+      unittest::ExpectEqual(int, doc.GetRowIdx("2024-01-03"), 0);
+
+      // filtered rows within range, given the cells as loaded
+      std::istringstream filterStream(csv);
+      std::vector<size_t> rowSizes;
+      rapidcsv::Document filterDoc(filterStream, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                   rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                   rapidcsv::LoadParams(false, 1, 0, {}, { "Value" }, 1, 6,
+                                                        [&](const std::vector<std::string>& pRow)
+                                                        {
+                                                          rowSizes.push_back(pRow.size());
+                                                          return pRow.at(0) >= "2024-01-05";
+                                                        }),
+                                   rapidcsv::StorageParams(layout));
+      unittest::ExpectTrue(filterDoc.GetColumn<int>("Value") == std::vector<int>({ 50, 60, 70 }));
+      unittest::ExpectEqual(std::string, filterDoc.GetRowName(2), "2024-01-07");
+      unittest::ExpectTrue(rowSizes == std::vector<size_t>(6, 2));
+    }
+
+    // range beyond the data, empty range and reading stopped within a stream
+    std::istringstream beyondStream(csv);
+    rapidcsv::Document beyondDoc(beyondStream, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(),
+                                 rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                 rapidcsv::LoadParams(false, 1, 0, {}, {}, 7, 5));
+    unittest::ExpectEqual(size_t, beyondDoc.GetRowCount(), 2);
+    unittest::ExpectEqual(std::string, beyondDoc.GetCell<std::string>(2, 1), "n9");
+
+    std::istringstream emptyStream(csv);
+    rapidcsv::Document emptyDoc(emptyStream, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(),
+                                rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                rapidcsv::LoadParams(false, 1, 0, {}, {}, 0, 0));
+    unittest::ExpectEqual(size_t, emptyDoc.GetRowCount(), 0);
+    unittest::ExpectEqual(size_t, emptyDoc.GetColumnCount(), 3);
+
+    std::string largeCsv = "A,B\n";
+    for (int i = 0; i < 100000; ++i)
+    {
+      largeCsv += std::to_string(i) + ",x\n";
+    }
+    for (const size_t threadCount : std::vector<size_t>({ 1, 4 }))
+    {
+      std::istringstream largeStream(largeCsv);
+      rapidcsv::Document largeDoc(largeStream, rapidcsv::LabelParams(0, -1), rapidcsv::SeparatorParams(),
+                                  rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                  rapidcsv::LoadParams(false, threadCount, 0, {}, {}, 70000, 2));
+      unittest::ExpectTrue(largeDoc.GetColumn<int>("A") == std::vector<int>({ 70000, 70001 }));
+      if (threadCount == 1)
+      {
+        // concurrent parsing reads all data up front
+        unittest::ExpectTrue(largeStream.tellg() < static_cast<std::streamoff>(largeCsv.size()));
+      }
+    }
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
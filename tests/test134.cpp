@@ -0,0 +1,136 @@
+// test134.cpp - random access to rows with a persistent row offset index
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "-,A,B\n"
+    "# comment\n"
+    "1,3,9\n"
+    "2,\"x\ny\",16\n"
+    "3,5,25\n"
+    "4,6,36\n"
+    "5,7,49"
+  ;
+
+  std::string path = unittest::TempPath();
+  std::string indexPath = path + ".idx";
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    const rapidcsv::SeparatorParams separatorParams(',', false, rapidcsv::sPlatformHasCR, true);
+    const rapidcsv::LineReaderParams lineReaderParams(true, '#');
+
+    // built and saved on first use
+    rapidcsv::IndexedReader reader(path, rapidcsv::LabelParams(0, 0), separatorParams, rapidcsv::ConverterParams(),
+                                   lineReaderParams, rapidcsv::IndexParams(2, 2));
+    unittest::ExpectTrue(!reader.IsIndexLoaded());
+    unittest::ExpectTrue(!unittest::ReadFile(indexPath).empty());
+    unittest::ExpectEqual(size_t, reader.GetRowCount(), 5);
+    unittest::ExpectEqual(size_t, reader.GetColumnCount(), 2);
+    unittest::ExpectTrue(reader.GetColumnNames() == std::vector<std::string>({ "A", "B" }));
+    unittest::ExpectEqual(int, reader.GetColumnIdx("B"), 1);
+    unittest::ExpectEqual(size_t, reader.GetBlockReadCount(), 1);
+
+    // blocks of two rows, at most two cached, least recently used evicted
+    unittest::ExpectEqual(int, reader.GetCell<int>("B", 0), 9);
+    unittest::ExpectEqual(size_t, reader.GetBlockReadCount(), 1);
+    unittest::ExpectEqual(std::string, reader.GetCell<std::string>("A", 1), "x\ny");
+    unittest::ExpectEqual(size_t, reader.GetBlockReadCount(), 2);
+    unittest::ExpectTrue(reader.GetRow<int>(4) == std::vector<int>({ 7, 49 }));
+    unittest::ExpectEqual(size_t, reader.GetBlockReadCount(), 3);
+    unittest::ExpectEqual(std::string, reader.GetRowName(2), "3");
+    unittest::ExpectEqual(size_t, reader.GetBlockReadCount(), 3);
+    unittest::ExpectEqual(int, reader.GetCell<int>(0, 0), 3);
+    unittest::ExpectEqual(size_t, reader.GetBlockReadCount(), 4);
+    unittest::ExpectEqual(int, reader.GetCell<int>(1, 2), 25);
+    unittest::ExpectEqual(size_t, reader.GetBlockReadCount(), 4);
+
+    ExpectExceptionMsg(reader.GetRow<int>(5), std::out_of_range, "row out of range: 5");
+    ExpectExceptionMsg(reader.GetCell<int>(2, 0), std::out_of_range, "column out of range: 2");
+    ExpectExceptionMsg(reader.GetCell<int>("C", 0), std::out_of_range, "column not found: C");
+
+    // same rows as a loaded document
+    rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), separatorParams, rapidcsv::ConverterParams(),
+                           lineReaderParams);
+    for (size_t rowIdx = 0; rowIdx < doc.GetRowCount(); ++rowIdx)
+    {
+      unittest::ExpectTrue(reader.GetRow<std::string>(rowIdx) == doc.GetRow<std::string>(rowIdx));
+      unittest::ExpectEqual(std::string, reader.GetRowName(rowIdx), doc.GetRowName(rowIdx));
+    }
+
+    // saved index reused with matching parameters, rebuilt otherwise
+    rapidcsv::IndexedReader loadedReader(path, rapidcsv::LabelParams(0, 0), separatorParams,
+                                         rapidcsv::ConverterParams(), lineReaderParams, rapidcsv::IndexParams(2, 2));
+    unittest::ExpectTrue(loadedReader.IsIndexLoaded());
+    unittest::ExpectEqual(size_t, loadedReader.GetRowCount(), 5);
+    unittest::ExpectEqual(std::string, loadedReader.GetCell<std::string>("A", 1), "x\ny");
+    unittest::ExpectEqual(int, loadedReader.GetCell<int>("B", 4), 49);
+
+    rapidcsv::IndexedReader strideReader(path, rapidcsv::LabelParams(0, 0), separatorParams,
+                                         rapidcsv::ConverterParams(), lineReaderParams, rapidcsv::IndexParams(3, 2));
+    unittest::ExpectTrue(!strideReader.IsIndexLoaded());
+    unittest::ExpectEqual(int, strideReader.GetCell<int>("B", 3), 36);
+
+    rapidcsv::IndexedReader lineReader(path, rapidcsv::LabelParams(0, 0), separatorParams,
+                                       rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                       rapidcsv::IndexParams(3, 2));
+    unittest::ExpectTrue(!lineReader.IsIndexLoaded());
+    unittest::ExpectEqual(size_t, lineReader.GetRowCount(), 6);
+    unittest::ExpectEqual(std::string, lineReader.GetRowName(0), "# comment");
+
+    // modified file of the same size, rewritten within the timestamp resolution
+    const std::string sameSizeCsv = csv.substr(0, csv.find("3,5,25")) + "3,5,2\n54,6,36\n5,7,49";
+    unittest::ExpectEqual(size_t, sameSizeCsv.size(), csv.size());
+    unittest::WriteFile(path, sameSizeCsv);
+    rapidcsv::IndexedReader sameSizeReader(path, rapidcsv::LabelParams(0, 0), separatorParams,
+                                           rapidcsv::ConverterParams(), lineReaderParams, rapidcsv::IndexParams(2, 2));
+    unittest::ExpectTrue(!sameSizeReader.IsIndexLoaded());
+    unittest::ExpectTrue(sameSizeReader.GetRow<int>(3) == std::vector<int>({ 6, 36 }));
+    unittest::ExpectEqual(std::string, sameSizeReader.GetRowName(3), "54");
+
+    // modified file
+    unittest::WriteFile(path, csv + "\n6,8,64\n");
+    rapidcsv::IndexedReader modifiedReader(path, rapidcsv::LabelParams(0, 0), separatorParams,
+                                           rapidcsv::ConverterParams(), lineReaderParams, rapidcsv::IndexParams(2, 2));
+    unittest::ExpectTrue(!modifiedReader.IsIndexLoaded());
+    unittest::ExpectEqual(size_t, modifiedReader.GetRowCount(), 6);
+    unittest::ExpectTrue(modifiedReader.GetRow<int>(5) == std::vector<int>({ 8, 64 }));
+
+    // no labels, and index not saved
+    unittest::DeleteFile(indexPath);
+    rapidcsv::IndexedReader unlabeledReader(path, rapidcsv::LabelParams(-1, -1), separatorParams,
+                                            rapidcsv::ConverterParams(), lineReaderParams,
+                                            rapidcsv::IndexParams(1024, 16, "", false /* pSaveIndex */));
+    unittest::ExpectTrue(unittest::ReadFile(indexPath).empty());
+    unittest::ExpectEqual(size_t, unlabeledReader.GetRowCount(), 7);
+    unittest::ExpectEqual(size_t, unlabeledReader.GetColumnCount(), 3);
+    unittest::ExpectTrue(unlabeledReader.GetColumnNames().empty());
+    unittest::ExpectTrue(unlabeledReader.GetRow<std::string>(0) == std::vector<std::string>({ "-", "A", "B" }));
+    ExpectException(unlabeledReader.GetRowName(0), std::out_of_range);
+
+    // empty file
+    unittest::WriteFile(path, "");
+    rapidcsv::IndexedReader emptyReader(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(),
+                                        rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(),
+                                        rapidcsv::IndexParams(2, 2, "", false));
+    unittest::ExpectEqual(size_t, emptyReader.GetRowCount(), 0);
+    unittest::ExpectEqual(size_t, emptyReader.GetColumnCount(), 0);
+    ExpectException(emptyReader.GetRow<int>(0), std::out_of_range);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(indexPath);
+
+  return rv;
+}
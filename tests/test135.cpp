@@ -0,0 +1,107 @@
+// test135.cpp - save and load binary snapshots
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "\xef\xbb\xbf"
+    "-;A;B\r\n"
+    "1;\"x;y\";9\r\n"
+    "2;;16\r\n"
+  ;
+
+  std::string path = unittest::TempPath();
+  std::string snapshotPath = unittest::TempPath();
+  unittest::WriteFile(path, csv);
+
+  try
+  {
+    const std::string savedCsv = [&]()
+    {
+      rapidcsv::Document doc(path, rapidcsv::LabelParams(0, 0), rapidcsv::SeparatorParams(';'));
+      doc.SaveSnapshot(snapshotPath);
+      std::ostringstream stream;
+      doc.Save(stream);
+      return stream.str();
+    }();
+
+    for (const rapidcsv::StorageLayout layout : { rapidcsv::StorageLayout::RowMajor,
+                                                  rapidcsv::StorageLayout::Buffer,
+                                                  rapidcsv::StorageLayout::ColumnMajor })
+    {
+      // labels, separator and encoding are restored from the snapshot
+      rapidcsv::Document doc;
+      doc.LoadSnapshot(snapshotPath, rapidcsv::ConverterParams(), rapidcsv::StorageParams(layout));
+      unittest::ExpectEqual(size_t, doc.GetRowCount(), 2);
+      unittest::ExpectEqual(size_t, doc.GetColumnCount(), 2);
+      unittest::ExpectTrue(doc.GetColumnNames() == std::vector<std::string>({ "A", "B" }));
+      unittest::ExpectTrue(doc.GetRowNames() == std::vector<std::string>({ "1", "2" }));
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("A", "1"), "x;y");
+      unittest::ExpectEqual(std::string, doc.GetCell<std::string>("A", "2"), "");
+      unittest::ExpectTrue(doc.GetColumn<int>("B") == std::vector<int>({ 9, 16 }));
+
+      std::ostringstream stream;
+      doc.Save(stream);
+      unittest::ExpectEqual(std::string, stream.str(), savedCsv);
+
+      // saved to the path of the original document
+      unittest::WriteFile(path, "");
+      doc.Save();
+      unittest::ExpectEqual(std::string, unittest::ReadFile(path), csv);
+    }
+
+    // dictionary encoding
+    std::istringstream labeledStream("k,v\nx,1\nx,2\ny,3\n");
+    rapidcsv::Document labeledDoc(labeledStream, rapidcsv::LabelParams(0, -1));
+    labeledDoc.SaveSnapshot(snapshotPath);
+    rapidcsv::Document encodedDoc;
+    encodedDoc.LoadSnapshot(snapshotPath, rapidcsv::ConverterParams(),
+                            rapidcsv::StorageParams(rapidcsv::StorageLayout::ColumnMajor, false, { "k" }));
+    unittest::ExpectTrue(encodedDoc.IsColumnDictionaryEncoded("k"));
+    unittest::ExpectTrue(encodedDoc.GetColumn<std::string>("k") == std::vector<std::string>({ "x", "x", "y" }));
+    unittest::ExpectTrue(encodedDoc.GetColumn<int>("v") == std::vector<int>({ 1, 2, 3 }));
+
+    // ragged rows
+    std::istringstream raggedStream("a,b\na,c,d\nb\n");
+    rapidcsv::Document raggedDoc(raggedStream, rapidcsv::LabelParams(-1, -1));
+    raggedDoc.SaveSnapshot(snapshotPath);
+    rapidcsv::Document bufferDoc;
+    bufferDoc.LoadSnapshot(snapshotPath, rapidcsv::ConverterParams(),
+                           rapidcsv::StorageParams(rapidcsv::StorageLayout::Buffer));
+    unittest::ExpectTrue(bufferDoc.GetRow<std::string>(0) == std::vector<std::string>({ "a", "b" }));
+    unittest::ExpectTrue(bufferDoc.GetRow<std::string>(1) == std::vector<std::string>({ "a", "c", "d" }));
+    unittest::ExpectTrue(bufferDoc.GetRow<std::string>(2) == std::vector<std::string>({ "b" }));
+    unittest::ExpectEqual(size_t, bufferDoc.GetStorageStats().mSlabCount, 1);
+
+    // empty document
+    rapidcsv::Document emptyDoc;
+    emptyDoc.SaveSnapshot(snapshotPath);
+    bufferDoc.LoadSnapshot(snapshotPath, rapidcsv::ConverterParams(),
+                           rapidcsv::StorageParams(rapidcsv::StorageLayout::Buffer));
+    unittest::ExpectEqual(size_t, bufferDoc.GetRowCount(), 0);
+
+    // invalid snapshots
+    unittest::WriteFile(snapshotPath, csv);
+    ExpectException(bufferDoc.LoadSnapshot(snapshotPath), std::invalid_argument);
+    raggedDoc.SaveSnapshot(snapshotPath);
+    const std::string snapshot = unittest::ReadFile(snapshotPath);
+    unittest::WriteFile(snapshotPath, snapshot.substr(0, snapshot.size() - 1));
+    ExpectException(bufferDoc.LoadSnapshot(snapshotPath), std::invalid_argument);
+    unittest::WriteFile(snapshotPath, "");
+    ExpectException(bufferDoc.LoadSnapshot(snapshotPath), std::invalid_argument);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  unittest::DeleteFile(path);
+  unittest::DeleteFile(snapshotPath);
+
+  return rv;
+}
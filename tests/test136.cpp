@@ -0,0 +1,54 @@
+// test136.cpp - trimming and unquoting of parsed cells
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  std::string csv =
+    "\"a\"\"b\",\"\"\"\"\"\",\"\"\"x\"\"\",\"\"\n"
+    "  \"c\"\"d\"  ,\"e,\"\"f\"\"\"  ,  g h  ,   \n"
+    "\"\"\"\",\"no\"\"end,\"\n"
+  ;
+
+  try
+  {
+    // trimmed, with quotes unescaped
+    std::istringstream sstream(csv);
+    rapidcsv::Document doc(sstream, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(',', true));
+    unittest::ExpectTrue(doc.GetRow<std::string>(0) == std::vector<std::string>({ "a\"b", "\"\"", "\"x\"", "" }));
+    unittest::ExpectTrue(doc.GetRow<std::string>(1) == std::vector<std::string>({ "c\"d", "e,\"f\"", "g h", "" }));
+    unittest::ExpectTrue(doc.GetRow<std::string>(2) == std::vector<std::string>({ "\"", "no\"end," }));
+
+    // untrimmed cells are only unquoted when starting and ending with quotes
+    std::istringstream untrimmedStream(csv);
+    rapidcsv::Document untrimmedDoc(untrimmedStream, rapidcsv::LabelParams(-1, -1));
+    unittest::ExpectTrue(untrimmedDoc.GetRow<std::string>(1) ==
+                         std::vector<std::string>({ "  \"c\"\"d\"  ", "\"e,\"\"f\"\"\"  ", "  g h  ", "   " }));
+    unittest::ExpectEqual(std::string, untrimmedDoc.GetCell<std::string>(0, 0), "a\"b");
+
+    // no unquoting without auto quote
+    std::istringstream rawStream(csv);
+    rapidcsv::Document rawDoc(rawStream, rapidcsv::LabelParams(-1, -1),
+                              rapidcsv::SeparatorParams(',', true, rapidcsv::sPlatformHasCR, false, false));
+    unittest::ExpectEqual(std::string, rawDoc.GetCell<std::string>(0, 0), "\"a\"\"b\"");
+    unittest::ExpectEqual(std::string, rawDoc.GetCell<std::string>(0, 1), "\"c\"\"d\"");
+
+    // comment lines detected by the decoded first cell
+    std::istringstream commentStream("\"#x\",1\n  # y,2\nz,3\n");
+    rapidcsv::Document commentDoc(commentStream, rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(',', true),
+                                  rapidcsv::ConverterParams(), rapidcsv::LineReaderParams(true, '#'),
+                                  rapidcsv::LoadParams(false, 1, 0, { 1 }));
+    unittest::ExpectEqual(size_t, commentDoc.GetRowCount(), 1);
+    unittest::ExpectEqual(int, commentDoc.GetCell<int>(0, 0), 3);
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}
@@ -0,0 +1,54 @@
+// test137.cpp - quoting and escaping of written cells
+
+#include <rapidcsv.h>
+#include "unittest.h"
+
+int main()
+{
+  int rv = 0;
+
+  const std::vector<std::string> cells = { "plain", "", "a b", "x;y", "\"", "\"\"q\"", "line\nbreak", "cr\r", "'s'" };
+
+  try
+  {
+    // document
+    rapidcsv::Document doc("", rapidcsv::LabelParams(-1, -1), rapidcsv::SeparatorParams(';', false, false));
+    doc.SetRow(0, cells);
+    std::ostringstream docStream;
+    doc.Save(docStream);
+    const std::string expected = "plain;;\"a b\";\"x;y\";\"\"\"\";\"\"\"\"\"q\"\"\";\"line\nbreak\";\"cr\r\";'s'\n";
+    unittest::ExpectEqual(std::string, docStream.str(), expected);
+
+    // writer
+    std::ostringstream writerStream;
+    {
+      rapidcsv::Writer writer(writerStream, rapidcsv::SeparatorParams(';', false, false));
+      writer.WriteRow(cells);
+    }
+    unittest::ExpectEqual(std::string, writerStream.str(), expected);
+
+    // other quote character
+    std::ostringstream quoteStream;
+    {
+      rapidcsv::Writer writer(quoteStream, rapidcsv::SeparatorParams(',', false, false, false, true, '\''));
+      writer.WriteRow(cells);
+    }
+    unittest::ExpectEqual(std::string, quoteStream.str(),
+                          "plain,,'a b',x;y,\",\"\"q\",'line\nbreak','cr\r','''s'''\n");
+
+    // no quoting
+    std::ostringstream rawStream;
+    {
+      rapidcsv::Writer writer(rawStream, rapidcsv::SeparatorParams(';', false, false, false, false));
+      writer.WriteRow(cells);
+    }
+    unittest::ExpectEqual(std::string, rawStream.str(), "plain;;a b;x;y;\";\"\"q\";line\nbreak;cr\r;'s'\n");
+  }
+  catch (const std::exception& ex)
+  {
+    std::cout << "exception: " << ex.what() << std::endl;
+    rv = 1;
+  }
+
+  return rv;
+}